@@ -2,6 +2,7 @@
 
 
 #include "Actors/MStdExecutor.h"
+#include "MTasksLog.h"
 
 namespace AMStdExecutorInternals
 {
@@ -27,14 +28,14 @@ UMTaskExecutor* AMStdExecutor::GetStdExecutor(UObject* WorldContextObject)
 {
 	if (!WorldContextObject)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("AMStdExecutor::GetStdExecutor: invalid context object"));
+		UE_LOG(LogMTasks, Warning, TEXT("AMStdExecutor::GetStdExecutor: invalid context object"));
 		return nullptr;
 	}
 
 	const auto World = WorldContextObject->GetWorld();
 	if (!World)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("AMStdExecutor::GetStdExecutor: No world associated with context object"));
+		UE_LOG(LogMTasks, Warning, TEXT("AMStdExecutor::GetStdExecutor: No world associated with context object"));
 		return nullptr;
 	}
 
@@ -75,7 +76,7 @@ void AMStdExecutor::Initialize()
 	// If the policy was not defined, spawn a standard policy.
 	if (!Policy.UseCustomPolicy)
 	{
-		UE_LOG(LogTemp, Display, TEXT("AMStdExecutor::Initialize: No execution policy was specified, using default"))
+		UE_LOG(LogMTasks, Display, TEXT("AMStdExecutor::Initialize: No execution policy was specified, using default"))
 		Policy = DefaultExecutionPolicy();
 	}
 
@@ -0,0 +1,276 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Debug/MTaskGraph.h"
+#include "Debug/MTaskOverlay.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "MExecutor.h"
+#include "MTaskNames.h"
+#include "UObject/UObjectIterator.h"
+
+namespace MTaskConsoleInternals
+{
+	/** Find a class by name; the U prefix and the _C suffix of blueprint classes are optional */
+	UClass* FindClass(const FString& Name)
+	{
+		for (TObjectIterator<UClass> It; It; ++It)
+		{
+			const auto ClassName = It->GetName();
+			if (ClassName == Name || ClassName == TEXT("U") + Name || ClassName == Name + TEXT("_C"))
+			{
+				return *It;
+			}
+		}
+		return nullptr;
+	}
+
+	void List(const TArray<FString>& Args, UWorld* World, FOutputDevice& Out)
+	{
+		const auto Filter = Args.Num() > 0 ? Args[0] : FString();
+		const auto Line = [&](const UObject* Object, EMTaskState State, EMTaskPriority Priority, const TCHAR* Note, float Duration,
+		                      const UObject* Context)
+		{
+			if (!Filter.IsEmpty() && !Object->GetClass()->GetName().Contains(Filter)) return;
+			Out.Logf(TEXT("  %s (%s) %s%s, %s priority, %.2fs, context %s"),
+			         *Object->GetName(),
+			         *Object->GetClass()->GetName(),
+			         *MTaskNames::ValueName(State),
+			         Note,
+			         *MTaskNames::ValueName(Priority),
+			         Duration,
+			         *GetNameSafe(Context));
+		};
+
+		UMTaskExecutor::ForEachExecutor(World, [&](UMTaskExecutor& Executor)
+		{
+			Out.Logf(TEXT("%s:"), *Executor.GetPathName());
+			Executor.ForEachTask([&](const FMTaskExecutorManagedTask& T)
+			{
+				Line(T.Task, T.Task->State, T.Priority, T.Started ? TEXT("") : TEXT(" (pending)"), T.ExecutionDuration, T.TaskContext);
+			});
+			Executor.ForEachCommand([&](const FMTaskExecutorManagedCommand& C)
+			{
+				const auto Note = C.Command->Suspended ? TEXT(" (suspended)") : C.Started ? TEXT("") : TEXT(" (pending)");
+				Line(C.Command, C.Command->State, C.Priority, Note, C.ExecutionDuration, C.TaskContext);
+			});
+		});
+	}
+
+	void ShowStats(const TArray<FString>& Args, UWorld* World, FOutputDevice& Out)
+	{
+		UMTaskExecutor::ForEachExecutor(World, [&](UMTaskExecutor& Executor)
+		{
+			const auto& Stats = Executor.GetStats();
+			Out.Logf(TEXT("%s:"), *Executor.GetPathName());
+			Out.Logf(TEXT("  queues: high %d, normal %d, low %d, pending %d, suspended %d"),
+			         Executor.GetQueueDepth(EMTaskPriority::High),
+			         Executor.GetQueueDepth(EMTaskPriority::Normal),
+			         Executor.GetQueueDepth(EMTaskPriority::Low),
+			         Executor.GetPendingDepth(),
+			         Executor.GetSuspendedDepth());
+			Out.Logf(TEXT("  last tick: %.3f ms, %d polled, %d deferred, %d started"),
+			         Stats.TickTime * 1000.0f, Stats.Polled, Stats.Deferred, Stats.Started);
+			Out.Logf(TEXT("  adaptive: %.2f ms average frame, throttle %.2f, low priority stride %d, budget %.3f ms, max starts %d"),
+			         Stats.AverageFrameTime * 1000.0f,
+			         Stats.ThrottleScale,
+			         Stats.LowPriorityStride,
+			         Stats.EffectiveTickBudget * 1000.0f,
+			         Stats.EffectiveMaxStartsPerTick);
+			Out.Logf(TEXT("  ticks: %lld, event log: %d events"), Executor.GetElapsedTicks(), Executor.GetEventLog().Num());
+		});
+	}
+
+	void Top(const TArray<FString>& Args, UWorld* World, FOutputDevice& Out)
+	{
+		const auto Mode = Args.Num() > 0 ? Args[0] : FString();
+		const auto Count = Mode.IsNumeric() ? FCString::Atoi(*Mode) : 10;
+
+		UMTaskExecutor::ForEachExecutor(World, [&](UMTaskExecutor& Executor)
+		{
+			if (Mode == TEXT("off"))
+			{
+				Executor.SetClassProfiling(false);
+				Executor.ResetClassCosts();
+				return;
+			}
+			if (Mode == TEXT("reset"))
+			{
+				Executor.ResetClassCosts();
+				return;
+			}
+			if (!Executor.IsClassProfiling())
+			{
+				Executor.SetClassProfiling(true);
+				Out.Logf(TEXT("%s: class profiling on; run mtasks.top again for results"), *Executor.GetPathName());
+				return;
+			}
+
+			TArray<TPair<UClass*, FMTaskClassCost>> Costs;
+			for (const auto& Cost : Executor.GetClassCosts())
+			{
+				if (Cost.Key.IsValid()) Costs.Emplace(Cost.Key.Get(), Cost.Value);
+			}
+			Costs.Sort([](const TPair<UClass*, FMTaskClassCost>& A, const TPair<UClass*, FMTaskClassCost>& B)
+			{
+				return A.Value.Seconds > B.Value.Seconds;
+			});
+
+			Out.Logf(TEXT("%s:"), *Executor.GetPathName());
+			for (auto i = 0; i < FMath::Min(Count, Costs.Num()); i++)
+			{
+				const auto& Cost = Costs[i].Value;
+				Out.Logf(TEXT("  %8.3f ms total  %8d polls  %7.1f us avg  %7.3f ms peak  %s"),
+				         Cost.Seconds * 1000.0f,
+				         Cost.Polls,
+				         Cost.Polls > 0 ? Cost.Seconds * 1000000.0f / Cost.Polls : 0.0f,
+				         Cost.PeakSeconds * 1000.0f,
+				         *Costs[i].Key->GetName());
+			}
+		});
+	}
+
+	void Cancel(const TArray<FString>& Args, UWorld* World, FOutputDevice& Out)
+	{
+		if (Args.Num() == 0)
+		{
+			Out.Logf(TEXT("Usage: mtasks.cancel <class>"));
+			return;
+		}
+		const auto Class = FindClass(Args[0]);
+		if (!Class)
+		{
+			Out.Logf(TEXT("No class named %s"), *Args[0]);
+			return;
+		}
+
+		auto Cancelled = 0;
+		UMTaskExecutor::ForEachExecutor(World, [&](UMTaskExecutor& Executor)
+		{
+			Cancelled += Executor.CancelAllByClass(Class);
+		});
+		Out.Logf(TEXT("Cancelled %d %s"), Cancelled, *Class->GetName());
+	}
+
+	void Memory(const TArray<FString>& Args, UWorld* World, FOutputDevice& Out)
+	{
+		const auto Count = Args.Num() > 0 && Args[0].IsNumeric() ? FCString::Atoi(*Args[0]) : 20;
+
+		SIZE_T Total = 0;
+		TMap<UClass*, FMTaskClassFootprint> Footprints;
+		UMTaskExecutor::ForEachExecutor(World, [&](UMTaskExecutor& Executor)
+		{
+			const auto Memory = Executor.GetMemoryUsage();
+			Out.Logf(TEXT("%s: %.1f KB (ready queues %.1f KB, pending %.1f KB, suspended %.1f KB, event log %.1f KB, caches %.1f KB)"),
+			         *Executor.GetPathName(),
+			         Memory.GetTotal() / 1024.0f,
+			         Memory.ReadyQueues / 1024.0f,
+			         Memory.Pending / 1024.0f,
+			         Memory.Suspended / 1024.0f,
+			         Memory.EventLog / 1024.0f,
+			         Memory.Caches / 1024.0f);
+			Total += Memory.GetTotal();
+			Executor.GetClassFootprints(Footprints);
+		});
+
+		Footprints.ValueSort([](const FMTaskClassFootprint& A, const FMTaskClassFootprint& B)
+		{
+			return A.GetTotal() > B.GetTotal();
+		});
+
+		Out.Logf(TEXT("Live tasks and commands by class:"));
+		Out.Logf(TEXT("  %8s %10s %10s %10s %10s %10s  %s"), TEXT("Count"), TEXT("Total KB"), TEXT("Object KB"), TEXT("Children"),
+		         TEXT("Delegates"), TEXT("Oldest s"), TEXT("Class"));
+		auto Shown = 0;
+		for (const auto& Footprint : Footprints)
+		{
+			const auto& F = Footprint.Value;
+			Total += F.GetTotal();
+			if (Shown++ >= Count) continue;
+			Out.Logf(TEXT("  %8d %10.1f %10.1f %10.1f %10.1f %10.1f  %s"),
+			         F.Count,
+			         F.GetTotal() / 1024.0f,
+			         F.ObjectBytes / 1024.0f,
+			         F.ChildrenBytes / 1024.0f,
+			         F.DelegateBytes / 1024.0f,
+			         F.OldestSeconds,
+			         *Footprint.Key->GetName());
+		}
+		Out.Logf(TEXT("Total: %.1f KB"), Total / 1024.0f);
+	}
+
+	void Overlay(const TArray<FString>& Args)
+	{
+		FMTaskOverlay::SetEnabled(Args.Num() > 0 ? Args[0].ToBool() : !FMTaskOverlay::IsEnabled());
+		if (Args.Num() > 1)
+		{
+			FMTaskOverlay::TopClasses = FMath::Max(FCString::Atoi(*Args[1]), 0);
+		}
+	}
+
+	void Graph(const TArray<FString>& Args, UWorld* World, FOutputDevice& Out)
+	{
+		const auto IncludeTree = Args.Contains(TEXT("tree"));
+		const auto WriteDot = Args.Contains(TEXT("dot"));
+
+		auto Count = 0;
+		UMTaskExecutor::ForEachExecutor(World, [&](UMTaskExecutor& Executor)
+		{
+			Out.Logf(TEXT("%s:"), *Executor.GetPathName());
+			const auto Graph = FMTaskGraph::Capture(Executor);
+			Graph.Dump(Out, IncludeTree);
+
+			if (WriteDot)
+			{
+				const auto Path = FPaths::Combine(FPaths::ProfilingDir(), TEXT("MTasks"), FString::Printf(TEXT("Graph-%d.dot"), Count));
+				if (FFileHelper::SaveStringToFile(Graph.ToDot(), *Path))
+				{
+					Out.Logf(TEXT("Wrote %s"), *Path);
+				}
+			}
+			Count += 1;
+		});
+
+		if (Count == 0)
+		{
+			Out.Logf(TEXT("No task executors"));
+		}
+	}
+}
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice GMTasksGraphCommand(
+	TEXT("mtasks.graph"),
+	TEXT("Snapshot the live task graphs and report the critical path and serial chains. ")
+	TEXT("Options: 'tree' prints every node, 'dot' writes Graphviz files to Saved/Profiling/MTasks."),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&MTaskConsoleInternals::Graph));
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice GMTasksListCommand(
+	TEXT("mtasks.list"),
+	TEXT("List every live task and command. Optionally, only those whose class name contains the argument."),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&MTaskConsoleInternals::List));
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice GMTasksStatsCommand(
+	TEXT("mtasks.stats"),
+	TEXT("Show queue depths, the last tick and the adaptive policy for every executor."),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&MTaskConsoleInternals::ShowStats));
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice GMTasksTopCommand(
+	TEXT("mtasks.top"),
+	TEXT("Show the task classes with the most poll time. The first run turns class profiling on. ")
+	TEXT("Options: a number of classes to show, 'reset' to clear the totals, 'off' to stop profiling."),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&MTaskConsoleInternals::Top));
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice GMTasksCancelCommand(
+	TEXT("mtasks.cancel"),
+	TEXT("Cancel every task and command of a class, eg. mtasks.cancel MStdDelay."),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&MTaskConsoleInternals::Cancel));
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice GMTasksMemCommand(
+	TEXT("mtasks.mem"),
+	TEXT("Show the memory held by every executor, and by its live tasks and commands per class. Optionally, how many classes to list."),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&MTaskConsoleInternals::Memory));
+
+static FAutoConsoleCommand GMTasksOverlayCommand(
+	TEXT("mtasks.overlay"),
+	TEXT("Toggle the executor overlay, or set it with 0 or 1. A second argument sets how many task classes are listed."),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&MTaskConsoleInternals::Overlay));
@@ -0,0 +1,334 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Debug/MTaskGraph.h"
+#include "MCommand.h"
+#include "MExecutor.h"
+#include "MTaskNames.h"
+
+namespace FMTaskGraphInternals
+{
+	/** Guard against cycles in Parent when looking for roots */
+	constexpr int32 MaxDepth = 1000;
+
+	/** When an object was started and completed, according to the event log */
+	struct FTiming
+	{
+		uint32 ClassId = 0;
+		uint64 Start = 0;
+		uint64 End = 0;
+	};
+
+	FString DurationText(const FMTaskGraphNode& Node)
+	{
+		return Node.HasTiming() ? FString::Printf(TEXT("%.2f ms"), Node.Duration * 1000.0) : FString(TEXT("n/a"));
+	}
+
+	void DumpTree(const FMTaskGraph& Graph, int32 Node, int32 Depth, FOutputDevice& Out)
+	{
+		const auto& N = Graph.Nodes[Node];
+		Out.Logf(TEXT("  %s%s%s (%s) %s %s%s"),
+		         *FString::ChrN(Depth * 2, TEXT(' ')),
+		         N.Parent != INDEX_NONE && !N.IsCommand ? *FString::Printf(TEXT("[%s] "), *MTaskNames::ValueName(N.Edge)) : TEXT(""),
+		         *N.Name,
+		         *N.ClassName,
+		         *MTaskNames::ValueName(N.State),
+		         *DurationText(N),
+		         N.IsOnCriticalPath ? TEXT(" *") : TEXT(""));
+		for (const auto Child : N.Children)
+		{
+			DumpTree(Graph, Child, Depth + 1, Out);
+		}
+	}
+
+	/** Does this child run? Only on the edge matching how its parent ended, or Resolved while the parent still runs */
+	bool IsTaken(const FMTaskGraph& Graph, int32 Child)
+	{
+		const auto& C = Graph.Nodes[Child];
+		if (C.IsCommand || C.Parent == INDEX_NONE) return true;
+		const auto ParentState = Graph.Nodes[C.Parent].State;
+		return C.Edge == (ParentState == EMTaskState::Rejected ? EMTaskState::Rejected : EMTaskState::Resolved);
+	}
+
+	/** The only child which runs after Node, if there is exactly one; commands don't count */
+	int32 SingleTakenChild(const FMTaskGraph& Graph, int32 Node)
+	{
+		auto Found = INDEX_NONE;
+		for (const auto Child : Graph.Nodes[Node].Children)
+		{
+			if (Graph.Nodes[Child].IsCommand || !IsTaken(Graph, Child)) continue;
+			if (Found != INDEX_NONE) return INDEX_NONE;
+			Found = Child;
+		}
+		return Found;
+	}
+}
+
+int32 FMTaskGraph::AddNode(UObject* Object, bool IsCommand, TMap<const UObject*, int32>& Index)
+{
+	const auto NodeIndex = Nodes.AddDefaulted();
+	auto& Node = Nodes[NodeIndex];
+	Node.Object = Object;
+	Node.Name = Object->GetName();
+	Node.ClassName = Object->GetClass()->GetName();
+	Node.IsCommand = IsCommand;
+	Node.State = IsCommand ? static_cast<UMCommand*>(Object)->State : static_cast<UMTask*>(Object)->State;
+	Index.Add(Object, NodeIndex);
+	return NodeIndex;
+}
+
+FMTaskGraph FMTaskGraph::Capture(const UMTaskExecutor& Executor)
+{
+	using namespace FMTaskGraphInternals;
+
+	TArray<UMTask*> LiveTasks;
+	TArray<UMCommand*> LiveCommands;
+	Executor.ForEachTask([&](const FMTaskExecutorManagedTask& T)
+	{
+		LiveTasks.Add(T.Task);
+	});
+	Executor.ForEachCommand([&](const FMTaskExecutorManagedCommand& C)
+	{
+		LiveCommands.Add(C.Command);
+	});
+
+	// Completed ancestors are still reachable through Parent while their children run
+	TArray<UMTask*> RootTasks;
+	for (const auto Task : LiveTasks)
+	{
+		auto Root = Task;
+		for (auto Depth = 0; Root->Parent.IsValid() && Depth < MaxDepth; Depth++)
+		{
+			Root = Root->Parent.Get();
+		}
+		RootTasks.AddUnique(Root);
+	}
+
+	FMTaskGraph Graph;
+	TMap<const UObject*, int32> Index;
+	for (const auto Root : RootTasks)
+	{
+		if (Index.Contains(Root)) continue;
+		Graph.Roots.Add(Graph.AddNode(Root, false, Index));
+
+		TArray<int32> Open;
+		Open.Add(Graph.Roots.Last());
+		while (Open.Num() > 0)
+		{
+			const auto Node = Open.Pop(false);
+			const auto Task = static_cast<UMTask*>(Graph.Nodes[Node].Object.Get());
+			for (const auto& ChildTask : Task->Children)
+			{
+				if (!ChildTask.Child.IsValid() || Index.Contains(ChildTask.Child.Get())) continue;
+				const auto Child = Graph.AddNode(ChildTask.Child.Get(), false, Index);
+				Graph.Nodes[Child].Parent = Node;
+				Graph.Nodes[Child].Edge = ChildTask.Type;
+				Graph.Nodes[Node].Children.Add(Child);
+				Open.Add(Child);
+			}
+		}
+	}
+
+	for (const auto Command : LiveCommands)
+	{
+		const auto Node = Graph.AddNode(Command, true, Index);
+		const auto Parent = Command->Parent.IsValid() ? Index.Find(Command->Parent.Get()) : nullptr;
+		if (Parent)
+		{
+			Graph.Nodes[Node].Parent = *Parent;
+			Graph.Nodes[*Parent].Children.Add(Node);
+		}
+		else
+		{
+			Graph.Roots.Add(Node);
+		}
+	}
+
+	// Per-node durations, from the event log
+	TMap<uint32, FTiming> Timings;
+	uint64 Origin = 0;
+	Executor.GetEventLog().ForEach([&](const FMTaskEvent& Event)
+	{
+		Origin = Origin ? Origin : Event.Cycles;
+		auto& Timing = Timings.FindOrAdd(Event.ObjectId);
+		switch (Event.Kind)
+		{
+		case EMTaskEvent::Queued:
+			// Unique ids are recycled; a new queue means a new object
+			Timing = FTiming();
+			Timing.ClassId = Event.ClassId;
+			break;
+		case EMTaskEvent::Started:
+			Timing.ClassId = Event.ClassId;
+			Timing.Start = Event.Cycles;
+			break;
+		case EMTaskEvent::Completed:
+		case EMTaskEvent::Cancelled:
+			Timing.End = Event.Cycles;
+			break;
+		default:
+			break;
+		}
+	});
+
+	const auto Now = FPlatformTime::Cycles64();
+	for (auto& Node : Graph.Nodes)
+	{
+		const auto Object = Node.Object.Get();
+		const auto Timing = Object ? Timings.Find(Object->GetUniqueID()) : nullptr;
+		if (!Timing || !Timing->Start || Timing->ClassId != Object->GetClass()->GetUniqueID()) continue;
+
+		Node.StartTime = FPlatformTime::ToSeconds64(Timing->Start - Origin);
+		Node.EndTime = Timing->End ? FPlatformTime::ToSeconds64(Timing->End - Origin) : -1;
+		Node.Duration = FPlatformTime::ToSeconds64((Timing->End ? Timing->End : Now) - Timing->Start);
+	}
+
+	Graph.Analyze();
+	return Graph;
+}
+
+void FMTaskGraph::Analyze(int32 MinChainLength)
+{
+	using namespace FMTaskGraphInternals;
+
+	// Children are always added after their parents, so walking backwards visits every child first
+	for (auto i = Nodes.Num() - 1; i >= 0; i--)
+	{
+		auto& Node = Nodes[i];
+		auto Longest = 0.0;
+		for (const auto Child : Node.Children)
+		{
+			if (!IsTaken(*this, Child)) continue;
+			Longest = FMath::Max(Longest, Nodes[Child].PathDuration);
+		}
+		Node.PathDuration = Node.Duration + Longest;
+		Node.IsOnCriticalPath = false;
+	}
+
+	CriticalPath.Reset();
+	CriticalPathDuration = 0;
+	auto Next = INDEX_NONE;
+	for (const auto Root : Roots)
+	{
+		if (Next == INDEX_NONE || Nodes[Root].PathDuration > Nodes[Next].PathDuration)
+		{
+			Next = Root;
+		}
+	}
+	if (Next != INDEX_NONE)
+	{
+		CriticalPathDuration = Nodes[Next].PathDuration;
+	}
+	while (Next != INDEX_NONE)
+	{
+		CriticalPath.Add(Next);
+		Nodes[Next].IsOnCriticalPath = true;
+
+		auto Longest = INDEX_NONE;
+		for (const auto Child : Nodes[Next].Children)
+		{
+			if (!IsTaken(*this, Child)) continue;
+			if (Longest == INDEX_NONE || Nodes[Child].PathDuration > Nodes[Longest].PathDuration)
+			{
+				Longest = Child;
+			}
+		}
+		Next = Longest;
+	}
+
+	// A chain starts at any task which is not itself the single taken child of its parent
+	SerialChains.Reset();
+	for (auto i = 0; i < Nodes.Num(); i++)
+	{
+		if (Nodes[i].IsCommand) continue;
+		const auto Parent = Nodes[i].Parent;
+		if (Parent != INDEX_NONE && SingleTakenChild(*this, Parent) == i) continue;
+
+		FMTaskGraphChain Chain;
+		for (auto Link = i; Link != INDEX_NONE; Link = SingleTakenChild(*this, Link))
+		{
+			Chain.Nodes.Add(Link);
+			Chain.SerialDuration += Nodes[Link].Duration;
+			Chain.ParallelDuration = FMath::Max(Chain.ParallelDuration, Nodes[Link].Duration);
+		}
+		if (Chain.Nodes.Num() >= MinChainLength)
+		{
+			SerialChains.Add(MoveTemp(Chain));
+		}
+	}
+	SerialChains.Sort([](const FMTaskGraphChain& A, const FMTaskGraphChain& B)
+	{
+		return A.SerialDuration - A.ParallelDuration > B.SerialDuration - B.ParallelDuration;
+	});
+}
+
+void FMTaskGraph::Dump(FOutputDevice& Out, bool IncludeTree) const
+{
+	using namespace FMTaskGraphInternals;
+	Out.Logf(TEXT("MTasks graph: %d nodes, %d roots"), Nodes.Num(), Roots.Num());
+
+	Out.Logf(TEXT("Critical path: %.2f ms over %d nodes"), CriticalPathDuration * 1000.0, CriticalPath.Num());
+	for (const auto Node : CriticalPath)
+	{
+		const auto& N = Nodes[Node];
+		Out.Logf(TEXT("  %s (%s) %s %s"), *N.Name, *N.ClassName, *MTaskNames::ValueName(N.State), *DurationText(N));
+	}
+
+	if (SerialChains.Num() > 0)
+	{
+		Out.Logf(TEXT("Serial chains; these could fan out if the links are independent:"));
+		for (const auto& Chain : SerialChains)
+		{
+			TArray<FString> Names;
+			for (const auto Node : Chain.Nodes)
+			{
+				Names.Add(Nodes[Node].Name);
+			}
+			Out.Logf(TEXT("  %s: %.2f ms chained, %.2f ms fanned out"),
+			         *FString::Join(Names, TEXT(" -> ")),
+			         Chain.SerialDuration * 1000.0,
+			         Chain.ParallelDuration * 1000.0);
+		}
+	}
+
+	if (IncludeTree)
+	{
+		Out.Logf(TEXT("Tree; * marks the critical path:"));
+		for (const auto Root : Roots)
+		{
+			DumpTree(*this, Root, 0, Out);
+		}
+	}
+}
+
+FString FMTaskGraph::ToDot() const
+{
+	using namespace FMTaskGraphInternals;
+
+	FString Out = TEXT("digraph MTasks {\n  node [shape=box, fontname=\"Helvetica\"];\n");
+	for (auto i = 0; i < Nodes.Num(); i++)
+	{
+		const auto& N = Nodes[i];
+		Out += FString::Printf(TEXT("  n%d [label=\"%s\\n%s\\n%s %s\"%s%s];\n"),
+		                       i,
+		                       *N.Name,
+		                       *N.ClassName,
+		                       *MTaskNames::ValueName(N.State),
+		                       *DurationText(N),
+		                       N.IsCommand ? TEXT(", style=rounded") : TEXT(""),
+		                       N.IsOnCriticalPath ? TEXT(", color=red, penwidth=2") : TEXT(""));
+	}
+	for (auto i = 0; i < Nodes.Num(); i++)
+	{
+		for (const auto Child : Nodes[i].Children)
+		{
+			const auto& C = Nodes[Child];
+			Out += FString::Printf(TEXT("  n%d -> n%d [label=\"%s\"%s];\n"),
+			                       i,
+			                       Child,
+			                       C.IsCommand ? TEXT("") : *MTaskNames::ValueName(C.Edge),
+			                       Nodes[i].IsOnCriticalPath && C.IsOnCriticalPath ? TEXT(", color=red, penwidth=2") : TEXT(""));
+		}
+	}
+	Out += TEXT("}\n");
+	return Out;
+}
@@ -0,0 +1,140 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Debug/MTaskOverlay.h"
+#include "Debug/DebugDrawService.h"
+#include "Engine/Canvas.h"
+#include "Engine/Engine.h"
+#include "GameFramework/PlayerController.h"
+#include "MExecutor.h"
+
+namespace FMTaskOverlayInternals
+{
+	/** Seconds between rebuilding the overlay text */
+	constexpr double RefreshInterval = 0.25;
+
+	/** Below the engine's own stat lines */
+	constexpr float Left = 20;
+	constexpr float Top = 120;
+}
+
+FDelegateHandle FMTaskOverlay::DrawHandle;
+TArray<FString> FMTaskOverlay::Lines;
+double FMTaskOverlay::LastRefresh = 0;
+TMap<TWeakObjectPtr<UMTaskExecutor>, FMTaskOverlay::FTotals> FMTaskOverlay::LastTotals;
+int32 FMTaskOverlay::TopClasses = 5;
+
+void FMTaskOverlay::SetEnabled(bool InEnabled)
+{
+	if (InEnabled == IsEnabled()) return;
+	if (InEnabled)
+	{
+		DrawHandle = UDebugDrawService::Register(TEXT("Game"), FDebugDrawDelegate::CreateStatic(&FMTaskOverlay::Draw));
+		LastRefresh = 0;
+	}
+	else
+	{
+		UDebugDrawService::Unregister(DrawHandle);
+		DrawHandle.Reset();
+		Lines.Reset();
+
+		// Put class profiling back the way each executor had it before the overlay turned it on
+		for (const auto& Totals : LastTotals)
+		{
+			if (const auto Executor = Totals.Key.Get())
+			{
+				Executor->SetClassProfiling(Totals.Value.WasProfiling);
+			}
+		}
+		LastTotals.Reset();
+	}
+}
+
+bool FMTaskOverlay::IsEnabled()
+{
+	return DrawHandle.IsValid();
+}
+
+void FMTaskOverlay::Draw(UCanvas* Canvas, APlayerController* PlayerController)
+{
+	using namespace FMTaskOverlayInternals;
+	if (!Canvas || !GEngine) return;
+
+	const auto Now = FPlatformTime::Seconds();
+	if (Now - LastRefresh >= RefreshInterval)
+	{
+		Refresh(PlayerController ? PlayerController->GetWorld() : nullptr);
+		LastRefresh = Now;
+	}
+
+	const auto Font = GEngine->GetSmallFont();
+	const auto LineHeight = Font->GetMaxCharHeight() + 2;
+	auto Y = Top;
+	Canvas->SetDrawColor(FColor::White);
+	for (const auto& Line : Lines)
+	{
+		Canvas->DrawText(Font, Line, Left, Y);
+		Y += LineHeight;
+	}
+}
+
+void FMTaskOverlay::Refresh(UWorld* World)
+{
+	Lines.Reset();
+	for (auto It = LastTotals.CreateIterator(); It; ++It)
+	{
+		if (!It.Key().IsValid()) It.RemoveCurrent();
+	}
+
+	UMTaskExecutor::ForEachExecutor(World, [](UMTaskExecutor& Executor)
+	{
+		auto Totals = LastTotals.Find(&Executor);
+		if (!Totals)
+		{
+			Totals = &LastTotals.Add(&Executor);
+			Totals->WasProfiling = Executor.IsClassProfiling();
+		}
+		Executor.SetClassProfiling(true);
+
+		const auto& Stats = Executor.GetStats();
+		Lines.Add(FString::Printf(TEXT("%s  tick %.3f ms  polled %d  deferred %d  started %d  throttle %.2f"),
+		                          *Executor.GetName(),
+		                          Stats.TickTime * 1000.0f,
+		                          Stats.Polled,
+		                          Stats.Deferred,
+		                          Stats.Started,
+		                          Stats.ThrottleScale));
+		Lines.Add(FString::Printf(TEXT("  queues  high %d  normal %d  low %d  pending %d  suspended %d"),
+		                          Executor.GetQueueDepth(EMTaskPriority::High),
+		                          Executor.GetQueueDepth(EMTaskPriority::Normal),
+		                          Executor.GetQueueDepth(EMTaskPriority::Low),
+		                          Executor.GetPendingDepth(),
+		                          Executor.GetSuspendedDepth()));
+
+		// Cost since the last refresh, averaged over the ticks in between
+		const auto Ticks = FMath::Max<int64>(Executor.GetElapsedTicks() - Totals->Ticks, 1);
+		TArray<TPair<UClass*, float>> Recent;
+		for (const auto& Cost : Executor.GetClassCosts())
+		{
+			if (!Cost.Key.IsValid()) continue;
+			const auto Previous = Totals->Seconds.FindRef(Cost.Key);
+			const auto Delta = Cost.Value.Seconds >= Previous ? Cost.Value.Seconds - Previous : Cost.Value.Seconds;
+			Totals->Seconds.Add(Cost.Key, Cost.Value.Seconds);
+			if (Delta > 0) Recent.Emplace(Cost.Key.Get(), Delta);
+		}
+		Totals->Ticks = Executor.GetElapsedTicks();
+
+		Recent.Sort([](const TPair<UClass*, float>& A, const TPair<UClass*, float>& B)
+		{
+			return A.Value > B.Value;
+		});
+		for (auto i = 0; i < FMath::Min(TopClasses, Recent.Num()); i++)
+		{
+			Lines.Add(FString::Printf(TEXT("  %.3f ms/tick  %s"), Recent[i].Value * 1000.0f / Ticks, *Recent[i].Key->GetName()));
+		}
+	});
+
+	if (Lines.Num() == 0)
+	{
+		Lines.Add(TEXT("No task executors"));
+	}
+}
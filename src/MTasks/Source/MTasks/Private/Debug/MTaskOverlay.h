@@ -0,0 +1,52 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class APlayerController;
+class UCanvas;
+class UMTaskExecutor;
+
+/**
+ * On-screen executor health: queue depths, tick cost and the most expensive task classes.
+ *
+ * Text is rebuilt a few times a second and only drawn in between, so a frame with the
+ * overlay showing costs a handful of DrawText calls. Showing the overlay turns on class
+ * profiling for the executors it draws; hiding it turns profiling back off unless it was
+ * already on.
+ */
+class FMTaskOverlay
+{
+public:
+	static void SetEnabled(bool InEnabled);
+
+	static bool IsEnabled();
+
+	/** Classes listed per executor */
+	static int32 TopClasses;
+
+private:
+	/** Class costs of an executor at the last refresh, so the overlay shows recent cost per tick */
+	struct FTotals
+	{
+		int64 Ticks = 0;
+		TMap<TWeakObjectPtr<UClass>, float> Seconds;
+
+		/** Class profiling before the overlay turned it on; restored when the overlay is hidden */
+		bool WasProfiling = false;
+	};
+
+	static void Draw(UCanvas* Canvas, APlayerController* PlayerController);
+
+	/** Rebuild Lines from the executors in a world */
+	static void Refresh(UWorld* World);
+
+	static FDelegateHandle DrawHandle;
+
+	static TArray<FString> Lines;
+
+	static double LastRefresh;
+
+	static TMap<TWeakObjectPtr<UMTaskExecutor>, FTotals> LastTotals;
+};
@@ -0,0 +1,34 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "MBatchCommand.h"
+#include "Async/ParallelFor.h"
+
+EMTaskState UMBatchCommand::OnPoll_Implementation(float DeltaTime)
+{
+	if (State != EMTaskState::Running) return State;
+
+	const auto Count = GetBatchNum();
+	if (ParallelChunkSize > 0 && Count > ParallelChunkSize)
+	{
+		const auto ChunkSize = ParallelChunkSize;
+		const auto Chunks = (Count + ChunkSize - 1) / ChunkSize;
+		ParallelFor(Chunks, [this, Count, ChunkSize, DeltaTime](int32 Chunk)
+		{
+			const auto Begin = Chunk * ChunkSize;
+			OnPollBatch(Begin, FMath::Min(Begin + ChunkSize, Count), DeltaTime);
+		});
+	}
+	else if (Count > 0)
+	{
+		OnPollBatch(0, Count, DeltaTime);
+	}
+
+	OnBatchPolled(DeltaTime);
+
+	if (ResolveWhenEmpty && GetBatchNum() == 0)
+	{
+		return EMTaskState::Resolved;
+	}
+	return State;
+}
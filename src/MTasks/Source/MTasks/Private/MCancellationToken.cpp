@@ -0,0 +1,14 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "MCancellationToken.h"
+
+UMCancellationToken* UMCancellationToken::CreateToken(UObject* WorldContextObject)
+{
+	return NewObject<UMCancellationToken>(WorldContextObject);
+}
+
+void UMCancellationToken::Cancel()
+{
+	Cancelled = true;
+}
@@ -28,3 +28,52 @@ void UMCommand::OnStart_Implementation(UObject* Context)
 {
 	// Default action; do nothing.
 }
+
+void UMCommand::Renew()
+{
+	Renewed = true;
+	if (Suspended)
+	{
+		Resume();
+	}
+}
+
+void UMCommand::Suspend()
+{
+	if (const auto Executor = OwningExecutor.Get())
+	{
+		Executor->SuspendCommand(this);
+	}
+}
+
+void UMCommand::Resume()
+{
+	if (const auto Executor = OwningExecutor.Get())
+	{
+		Executor->ResumeCommand(this);
+	}
+}
+
+bool UMCommand::ConsumeRenewal()
+{
+	const auto WasRenewed = Renewed;
+	Renewed = false;
+	return WasRenewed;
+}
+
+FMTaskQueryCache* UMCommand::GetQueryCache() const
+{
+	const auto Executor = OwningExecutor.Get();
+	return Executor ? &Executor->GetQueryCache() : nullptr;
+}
+
+SIZE_T UMCommand::GetDelegatesAllocatedSize() const
+{
+	return OnUpdate.GetAllocatedSize() + Update.GetAllocatedSize();
+}
+
+void UMCommand::GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize)
+{
+	Super::GetResourceSizeEx(CumulativeResourceSize);
+	CumulativeResourceSize.AddDedicatedSystemMemoryBytes(GetDelegatesAllocatedSize());
+}
@@ -2,6 +2,40 @@
 
 
 #include "MExecutor.h"
+#include "MTasksLog.h"
+#include "HAL/FileManager.h"
+#include "Misc/App.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "UObject/UObjectIterator.h"
+
+DECLARE_STATS_GROUP(TEXT("MTasks"), STATGROUP_MTasks, STATCAT_Advanced);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Polled"), STAT_MTasksPolled, STATGROUP_MTasks);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Deferred"), STAT_MTasksDeferred, STATGROUP_MTasks);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Started"), STAT_MTasksStarted, STATGROUP_MTasks);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Throttle scale"), STAT_MTasksThrottleScale, STATGROUP_MTasks);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Low priority stride"), STAT_MTasksLowPriorityStride, STATGROUP_MTasks);
+DECLARE_MEMORY_STAT(TEXT("Executor memory"), STAT_MTasksExecutorMemory, STATGROUP_MTasks);
+
+namespace UMTaskExecutorInternals
+{
+	/** Frames of history averaged by the adaptive policy */
+	constexpr int32 FrameHistory = 30;
+
+	/** Ticks between adaptive adjustments, so each change has time to show in the history */
+	constexpr int32 AdaptInterval = 10;
+
+	/** Over target, throughput drops by this factor; with headroom it recovers by AdaptRecoverStep */
+	constexpr float AdaptBackoff = 0.8f;
+	constexpr float AdaptRecoverStep = 0.05f;
+
+	/** Frame time must be under this fraction of the target to count as headroom */
+	constexpr float AdaptHeadroom = 0.85f;
+
+	/** The watchdog doubles a throttled entry's intervals up to these; about the same time at 60 fps */
+	constexpr int32 MaxThrottleTicks = 64;
+	constexpr float MaxThrottleSeconds = 1.0f;
+}
 
 void UMTaskExecutor::SetActive(bool InActive)
 {
@@ -20,15 +54,12 @@ UMTask* UMTaskExecutor::FindFirstUnresolvedParent(UMTask* Task, int MaxIteration
 		Iteration += 1;
 		if (Iteration > MaxIterations)
 		{
-			UE_LOG(LogTemp, Warning, TEXT("UMTaskExecutor: Hit max iterations find parent. Maybe cycle in %s"), *Task->GetName());
+			UE_LOG(LogMTasks, Warning, TEXT("UMTaskExecutor: Hit max iterations find parent. Maybe cycle in %s"), *Task->GetName());
 			return nullptr;
 		}
 	}
 
-	if (Task != EffectiveTask && VerboseLogging)
-	{
-		UE_LOG(LogTemp, Display, TEXT("UMTaskExecutor: Using root task %s parent of %s"), *EffectiveTask->GetName(), *Task->GetName());
-	}
+	MTASKS_TRACE(VerboseLogging && Task != EffectiveTask, TEXT("UMTaskExecutor: Using root task %s parent of %s"), *EffectiveTask->GetName(), *Task->GetName());
 
 	return EffectiveTask;
 }
@@ -43,53 +74,118 @@ void UMTaskExecutor::RunTask(UMTask* Task, UObject* TaskContext)
 
 	if (Task->State != EMTaskState::Idle && Task->State != EMTaskState::Waiting)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("UMTaskExecutor: Invalid attempt to run an invalid task"));
+		UE_LOG(LogMTasks, Warning, TEXT("UMTaskExecutor: Invalid attempt to run an invalid task"));
 		return;
 	}
 
 	// Add to the pending tasks queue.
 	PendingTasks.Add(FMTaskExecutorManagedTask(Task, TaskContext));
-
-	// Start
 	Task->State = EMTaskState::Running;
-	Task->OnStart(TaskContext);
+	Task->OwningExecutor = this;
+	EventLog.Record(EMTaskEvent::Queued, Task, EMTaskState::Idle, EMTaskState::Running, ElapsedTicks, false);
 
-	if (VerboseLogging)
+	// With admission control, OnStart is deferred until the executor admits the task
+	if (Policy.MaxStartsPerTick > 0)
 	{
-		UE_LOG(LogTemp, Display, TEXT("UMTaskExecutor: %d: Started: %s"), ElapsedTicks, *Task->GetName());
+		MTASKS_TRACE(VerboseLogging, TEXT("UMTaskExecutor: %d: Queued: %s"), ElapsedTicks, *Task->GetName());
+		return;
 	}
+
+	// Start
+	StartManagedTask(PendingTasks.Last());
 }
 
 void UMTaskExecutor::RunCommand(UMCommand* Command, UObject* TaskContext)
 {
 	if (Command->State != EMTaskState::Idle && Command->State != EMTaskState::Waiting)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("UMTaskExecutor::Run: Invalid attempt to run an invalid command"));
+		UE_LOG(LogMTasks, Warning, TEXT("UMTaskExecutor::Run: Invalid attempt to run an invalid command"));
 		return;
 	}
 
 	// Add to the pending tasks queue.
 	PendingCommands.Add(FMTaskExecutorManagedCommand(Command, TaskContext));
+	PendingCommands.Last().CommandPolicy = ResolveCommandPolicy(Command->GetClass());
+	Command->State = EMTaskState::Running;
+	Command->OwningExecutor = this;
+	EventLog.Record(EMTaskEvent::Queued, Command, EMTaskState::Idle, EMTaskState::Running, ElapsedTicks, true);
+
+	// With admission control, OnStart is deferred until the executor admits the command
+	if (Policy.MaxStartsPerTick > 0)
+	{
+		MTASKS_TRACE(VerboseLogging, TEXT("UMTaskExecutor: %d: Queued: %s"), ElapsedTicks, *Command->GetName());
+		return;
+	}
 
 	// Start
-	Command->State = EMTaskState::Running;
-	Command->OnStart(TaskContext);
+	StartManagedCommand(PendingCommands.Last());
+}
+
+void UMTaskExecutor::StartManagedTask(FMTaskExecutorManagedTask& Task)
+{
+	// A task holding a token that is already cancelled, eg. one inherited from its parent, is rejected unstarted.
+	if (Task.Task->CancellationToken && Task.Task->CancellationToken->IsCancelled())
+	{
+		EventLog.Record(EMTaskEvent::Cancelled, Task.Task, Task.Task->State, EMTaskState::Rejected, ElapsedTicks, false);
+		Task.Task->State = EMTaskState::Rejected;
+		Task.Completed = true;
+		return;
+	}
 
-	if (VerboseLogging)
+	// OnStart may run other tasks and reallocate the list holding this entry, so don't touch it afterwards.
+	auto const StartingTask = Task.Task;
+	auto const StartingContext = Task.TaskContext;
+	Task.Started = true;
+	auto const StartTime = Policy.WatchdogThreshold > 0 ? FPlatformTime::Seconds() : 0;
+	DispatchOnStart(StartingTask, StartingContext);
+	if (Policy.WatchdogThreshold > 0)
 	{
-		UE_LOG(LogTemp, Display, TEXT("UMTaskExecutor: %d: Started: %s"), ElapsedTicks, *Command->GetName());
+		ReportSlowCall(TEXT("OnStart"), StartingTask, StartingContext, FPlatformTime::Seconds() - StartTime);
 	}
+
+	EventLog.Record(EMTaskEvent::Started, StartingTask, EMTaskState::Running, StartingTask->State, ElapsedTicks, false);
+	MTASKS_TRACE(VerboseLogging, TEXT("UMTaskExecutor: %d: Started: %s"), ElapsedTicks, *StartingTask->GetName());
+}
+
+void UMTaskExecutor::StartManagedCommand(FMTaskExecutorManagedCommand& Cmd)
+{
+	// A command holding a token that is already cancelled is rejected unstarted.
+	if (Cmd.Command->CancellationToken && Cmd.Command->CancellationToken->IsCancelled())
+	{
+		EventLog.Record(EMTaskEvent::Cancelled, Cmd.Command, Cmd.Command->State, EMTaskState::Rejected, ElapsedTicks, true);
+		Cmd.Command->State = EMTaskState::Rejected;
+		Cmd.Completed = true;
+		return;
+	}
+
+	// OnStart may run other commands and reallocate the list holding this entry, so don't touch it afterwards.
+	auto const StartingCommand = Cmd.Command;
+	auto const StartingContext = Cmd.TaskContext;
+	Cmd.Started = true;
+	auto const StartTime = Policy.WatchdogThreshold > 0 ? FPlatformTime::Seconds() : 0;
+	DispatchOnStart(StartingCommand, StartingContext);
+	if (Policy.WatchdogThreshold > 0)
+	{
+		ReportSlowCall(TEXT("OnStart"), StartingCommand, StartingContext, FPlatformTime::Seconds() - StartTime);
+	}
+
+	EventLog.Record(EMTaskEvent::Started, StartingCommand, EMTaskState::Running, StartingCommand->State, ElapsedTicks, true);
+	MTASKS_TRACE(VerboseLogging, TEXT("UMTaskExecutor: %d: Started: %s"), ElapsedTicks, *StartingCommand->GetName());
 }
 
 void UMTaskExecutor::CancelTask(UMTask* Task)
 {
+	EventLog.Record(EMTaskEvent::Cancelled, Task, Task->State, EMTaskState::Rejected, ElapsedTicks, false);
 	Task->State = EMTaskState::Rejected;
-	for (auto& TaskRef : RunningTasks)
+	for (auto& Queue : ReadyQueues)
 	{
-		if (TaskRef.Task == Task)
+		for (auto& TaskRef : Queue.Tasks)
 		{
-			TaskRef.Completed = true;
-			return;
+			if (TaskRef.Task == Task)
+			{
+				TaskRef.Completed = true;
+				return;
+			}
 		}
 	}
 	for (auto& TaskRef : PendingTasks)
@@ -104,13 +200,17 @@ void UMTaskExecutor::CancelTask(UMTask* Task)
 
 void UMTaskExecutor::CancelCommand(UMCommand* Command)
 {
+	EventLog.Record(EMTaskEvent::Cancelled, Command, Command->State, EMTaskState::Rejected, ElapsedTicks, true);
 	Command->State = EMTaskState::Rejected;
-	for (auto& Cmd : RunningCommands)
+	for (auto& Queue : ReadyQueues)
 	{
-		if (Cmd.Command == Command)
+		for (auto& Cmd : Queue.Commands)
 		{
-			Cmd.Completed = true;
-			return;
+			if (Cmd.Command == Command)
+			{
+				Cmd.Completed = true;
+				return;
+			}
 		}
 	}
 	for (auto& Cmd : PendingCommands)
@@ -121,6 +221,167 @@ void UMTaskExecutor::CancelCommand(UMCommand* Command)
 			return;
 		}
 	}
+
+	// Suspended commands aren't polled; send them back through admission so OnEnd is dispatched
+	const auto Suspended = SuspendedCommands.IndexOfByPredicate([&](const FMTaskExecutorManagedCommand& Cmd)
+	{
+		return Cmd.Command == Command;
+	});
+	if (Suspended != INDEX_NONE)
+	{
+		SuspendedCommands[Suspended].Completed = true;
+		Command->Suspended = false;
+		PendingCommands.Add(SuspendedCommands[Suspended]);
+		SuspendedCommands.RemoveAt(Suspended);
+	}
+}
+
+void UMTaskExecutor::SuspendCommand(UMCommand* Command)
+{
+	if (!Command || Command->Suspended || !Command->IsRunning()) return;
+	Command->Suspended = true;
+	MTASKS_TRACE(VerboseLogging, TEXT("UMTaskExecutor: %d: Suspended: %s"), ElapsedTicks, *Command->GetName());
+}
+
+void UMTaskExecutor::ResumeCommand(UMCommand* Command)
+{
+	if (!Command || !Command->Suspended) return;
+	Command->Suspended = false;
+	Command->Renew();
+	MTASKS_TRACE(VerboseLogging, TEXT("UMTaskExecutor: %d: Resumed: %s"), ElapsedTicks, *Command->GetName());
+
+	// If it has not been moved off the ready queue yet, clearing the flag is enough
+	const auto Suspended = SuspendedCommands.IndexOfByPredicate([&](const FMTaskExecutorManagedCommand& Cmd)
+	{
+		return Cmd.Command == Command;
+	});
+	if (Suspended != INDEX_NONE)
+	{
+		PendingCommands.Add(SuspendedCommands[Suspended]);
+		SuspendedCommands.RemoveAt(Suspended);
+	}
+}
+
+void UMTaskExecutor::CancelTree(UMTask* Task)
+{
+	if (!Task) return;
+
+	// Collect the whole tree first, so the executor only needs to be scanned once.
+	TSet<UMTask*> Tree;
+	TArray<UMTask*> Open;
+	Open.Add(Task);
+	while (Open.Num() > 0)
+	{
+		auto const Next = Open.Pop(false);
+		bool IsAlreadyInTree = false;
+		Tree.Add(Next, &IsAlreadyInTree);
+		if (IsAlreadyInTree) continue;
+
+		if (Next->IsPending())
+		{
+			// Never reached an executor queue, so CancelWhere can't see it; queue a completed entry
+			// so it gets the same completion dispatch as the cancelled running tasks.
+			EventLog.Record(EMTaskEvent::Cancelled, Next, Next->State, EMTaskState::Rejected, ElapsedTicks, false);
+			Next->OwningExecutor = this;
+			// It never started, so it is not Started and gets no OnEnd.
+			PendingTasks.Add_GetRef(FMTaskExecutorManagedTask(Next, nullptr)).Completed = true;
+		}
+		if (!Next->IsCompleted())
+		{
+			Next->State = EMTaskState::Rejected;
+		}
+		for (const auto& ChildTask : Next->Children)
+		{
+			if (ChildTask.Child.IsValid())
+			{
+				Open.Add(ChildTask.Child.Get());
+			}
+		}
+	}
+
+	CancelWhere([&](const FMTaskExecutorManagedTask& T)
+	            {
+		            return Tree.Contains(T.Task);
+	            },
+	            [&](const FMTaskExecutorManagedCommand& C)
+	            {
+		            return C.Command->Parent.IsValid() && Tree.Contains(C.Command->Parent.Get());
+	            });
+}
+
+void UMTaskExecutor::CancelAllByContext(UObject* TaskContext)
+{
+	CancelWhere([&](const FMTaskExecutorManagedTask& T)
+	            {
+		            return T.TaskContext == TaskContext;
+	            },
+	            [&](const FMTaskExecutorManagedCommand& C)
+	            {
+		            return C.TaskContext == TaskContext;
+	            });
+}
+
+void UMTaskExecutor::CancelAllByToken(UMCancellationToken* Token)
+{
+	if (!Token) return;
+	Token->Cancel();
+	CancelWhere([&](const FMTaskExecutorManagedTask& T)
+	            {
+		            return T.Task->CancellationToken == Token;
+	            },
+	            [&](const FMTaskExecutorManagedCommand& C)
+	            {
+		            return C.Command->CancellationToken == Token;
+	            });
+}
+
+void UMTaskExecutor::CancelWhere(TFunctionRef<bool(const FMTaskExecutorManagedTask&)> TaskFilter,
+                                 TFunctionRef<bool(const FMTaskExecutorManagedCommand&)> CommandFilter)
+{
+	// Matching entries are only marked here; completion events are dispatched and the
+	// entries pruned by the next ProcessTasks / ProcessCommands.
+	auto const CancelTasks = [&](TArray<FMTaskExecutorManagedTask>& Tasks)
+	{
+		for (auto& T : Tasks)
+		{
+			if (!T.Completed && TaskFilter(T))
+			{
+				EventLog.Record(EMTaskEvent::Cancelled, T.Task, T.Task->State, EMTaskState::Rejected, ElapsedTicks, false);
+				T.Task->State = EMTaskState::Rejected;
+				T.Completed = true;
+			}
+		}
+	};
+	auto const CancelCommands = [&](TArray<FMTaskExecutorManagedCommand>& Commands)
+	{
+		for (auto& C : Commands)
+		{
+			if (!C.Completed && CommandFilter(C))
+			{
+				EventLog.Record(EMTaskEvent::Cancelled, C.Command, C.Command->State, EMTaskState::Rejected, ElapsedTicks, true);
+				C.Command->State = EMTaskState::Rejected;
+				C.Completed = true;
+			}
+		}
+	};
+
+	for (auto& Queue : ReadyQueues)
+	{
+		CancelTasks(Queue.Tasks);
+		CancelCommands(Queue.Commands);
+	}
+	CancelTasks(PendingTasks);
+	CancelCommands(PendingCommands);
+
+	// Suspended commands aren't polled; send them back through admission so OnEnd is dispatched
+	CancelCommands(SuspendedCommands);
+	for (const auto& C : SuspendedCommands)
+	{
+		if (!C.Completed) continue;
+		C.Command->Suspended = false;
+		PendingCommands.Add(C);
+	}
+	SuspendedCommands.RemoveAll(UMTaskExecutor::IsCommandCompletedPredicate);
 }
 
 void UMTaskExecutor::SetDebug(bool InVerboseLogging)
@@ -128,37 +389,367 @@ void UMTaskExecutor::SetDebug(bool InVerboseLogging)
 	VerboseLogging = InVerboseLogging;
 }
 
+void UMTaskExecutor::SetBudgetClock(TFunction<double()> InClock)
+{
+	BudgetClock = MoveTemp(InClock);
+}
+
+int32 UMTaskExecutor::CancelAllByClass(UClass* Class)
+{
+	if (!Class) return 0;
+	auto Cancelled = 0;
+	CancelWhere([&](const FMTaskExecutorManagedTask& T)
+	            {
+		            const auto IsMatch = T.Task->IsA(Class);
+		            Cancelled += IsMatch ? 1 : 0;
+		            return IsMatch;
+	            },
+	            [&](const FMTaskExecutorManagedCommand& C)
+	            {
+		            const auto IsMatch = C.Command->IsA(Class);
+		            Cancelled += IsMatch ? 1 : 0;
+		            return IsMatch;
+	            });
+	return Cancelled;
+}
+
+int32 UMTaskExecutor::ScanForOrphans(bool Collect)
+{
+	auto Unbound = 0;
+	auto Dangling = 0;
+	TMap<UClass*, int32> ByClass;
+
+	const auto IsUnbound = [&](const FMTaskExecutorManagedCommand& C)
+	{
+		if (Policy.UnboundCommandTimeout <= 0 || !C.Started || C.ExecutionDuration < Policy.UnboundCommandTimeout) return false;
+		if (C.Command->Parent.IsValid() || C.Command->OnUpdate.IsBound() || C.Command->Update.IsBound()) return false;
+		Unbound += 1;
+		ByClass.FindOrAdd(C.Command->GetClass()) += 1;
+		return true;
+	};
+	if (Collect)
+	{
+		CancelWhere([](const FMTaskExecutorManagedTask&) { return false; }, IsUnbound);
+	}
+	else
+	{
+		ForEachCommand([&](const FMTaskExecutorManagedCommand& C) { IsUnbound(C); });
+	}
+
+	// A command whose parent has been destroyed runs on, but is cut off from CancelTree. Running tasks
+	// are not checked; their parent has completed by definition, and may well have been collected.
+	ForEachCommand([&](const FMTaskExecutorManagedCommand& C)
+	{
+		if (!C.Command->Parent.IsStale()) return;
+		Dangling += 1;
+		ByClass.FindOrAdd(C.Command->GetClass()) += 1;
+		if (Collect) C.Command->Parent.Reset();
+	});
+
+	const auto Total = Unbound + Dangling;
+	Stats.Orphans = Total;
+	if (Total == 0) return 0;
+
+	if (Collect)
+	{
+		Stats.OrphansCollected += Unbound;
+	}
+
+	ByClass.ValueSort([](int32 A, int32 B) { return A > B; });
+	UE_LOG(LogMTasks, Warning, TEXT("UMTaskExecutor: %s %d orphans; %d unbound commands, %d dangling parents. Most are %s"),
+	       Collect ? TEXT("Collected") : TEXT("Found"),
+	       Total,
+	       Unbound,
+	       Dangling,
+	       *GetNameSafe(ByClass.CreateConstIterator().Key()));
+	return Total;
+}
+
+void UMTaskExecutor::RejectOrphanTree(UMTask* Root)
+{
+	TArray<UMTask*> Open;
+	Open.Add(Root);
+	while (Open.Num() > 0)
+	{
+		const auto Next = Open.Pop(false);
+		if (!Next->IsPending()) continue;
+
+		// Like the pending descendants of CancelTree, queue an unstarted completed entry, so its listeners
+		// hear the outcome through the usual completion dispatch; the whole chain is rejected before that
+		// runs, so nothing in it is promoted.
+		EventLog.Record(EMTaskEvent::Cancelled, Next, Next->State, EMTaskState::Rejected, ElapsedTicks, false);
+		Next->State = EMTaskState::Rejected;
+		Next->Parent = nullptr;
+		Next->OwningExecutor = this;
+		PendingTasks.Add_GetRef(FMTaskExecutorManagedTask(Next, nullptr)).Completed = true;
+		for (const auto& ChildTask : Next->Children)
+		{
+			if (ChildTask.Child.IsValid())
+			{
+				Open.Add(ChildTask.Child.Get());
+			}
+		}
+	}
+}
+
+int32 UMTaskExecutor::GetQueueDepth(EMTaskPriority Priority) const
+{
+	const auto Level = static_cast<int32>(Priority);
+	if (!ReadyQueues.IsValidIndex(Level)) return 0;
+	return ReadyQueues[Level].Tasks.Num() + ReadyQueues[Level].Commands.Num();
+}
+
+void UMTaskExecutor::SetClassProfiling(bool InProfileClasses)
+{
+	ProfileClasses = InProfileClasses;
+}
+
+void UMTaskExecutor::RecordClassCost(const UObject* Object, double Seconds) const
+{
+	auto& Cost = ClassCosts.FindOrAdd(Object->GetClass());
+	Cost.Polls += 1;
+	Cost.Seconds += Seconds;
+	Cost.PeakSeconds = FMath::Max(Cost.PeakSeconds, static_cast<float>(Seconds));
+}
+
+void UMTaskExecutor::DumpEventLog() const
+{
+	EventLog.Dump(*GLog);
+}
+
+void UMTaskExecutor::ForEachExecutor(UWorld* World, TFunctionRef<void(UMTaskExecutor&)> Visitor)
+{
+	for (TObjectIterator<UMTaskExecutor> It; It; ++It)
+	{
+		if (It->HasAnyFlags(RF_ClassDefaultObject | RF_ArchetypeObject)) continue;
+		if (World && It->GetWorld() != World) continue;
+		Visitor(**It);
+	}
+}
+
+void UMTaskExecutor::ForEachTask(TFunctionRef<void(const FMTaskExecutorManagedTask&)> Visitor) const
+{
+	for (const auto& Queue : ReadyQueues)
+	{
+		for (const auto& T : Queue.Tasks)
+		{
+			if (!T.Completed) Visitor(T);
+		}
+	}
+	for (const auto& T : PendingTasks)
+	{
+		if (!T.Completed) Visitor(T);
+	}
+}
+
+void UMTaskExecutor::ForEachCommand(TFunctionRef<void(const FMTaskExecutorManagedCommand&)> Visitor) const
+{
+	for (const auto& Queue : ReadyQueues)
+	{
+		for (const auto& C : Queue.Commands)
+		{
+			if (!C.Completed) Visitor(C);
+		}
+	}
+	for (const auto& C : PendingCommands)
+	{
+		if (!C.Completed) Visitor(C);
+	}
+	for (const auto& C : SuspendedCommands)
+	{
+		if (!C.Completed) Visitor(C);
+	}
+}
+
+FString UMTaskExecutor::ExportEventLog(const FString& Filename, bool AsCsv) const
+{
+	auto Path = Filename;
+	if (FPaths::IsRelative(Path))
+	{
+		Path = FPaths::Combine(FPaths::ProfilingDir(), TEXT("MTasks"), Path);
+	}
+	IFileManager::Get().MakeDirectory(*FPaths::GetPath(Path), true);
+
+	const auto Contents = AsCsv ? EventLog.ToCsv() : EventLog.ToChromeTrace();
+	if (!FFileHelper::SaveStringToFile(Contents, *Path))
+	{
+		UE_LOG(LogMTasks, Warning, TEXT("UMTaskExecutor: Failed to export event log to %s"), *Path);
+		return FString();
+	}
+
+	UE_LOG(LogMTasks, Display, TEXT("UMTaskExecutor: Exported %d events to %s"), EventLog.Num(), *Path);
+	return Path;
+}
+
+void UMTaskExecutor::ReportSlowCall(const TCHAR* Event, const UObject* Object, const UObject* Context, double Seconds) const
+{
+	if (Seconds <= Policy.WatchdogThreshold) return;
+	UE_LOG(LogMTasks, Warning, TEXT("UMTaskExecutor: Slow %s: %.2f ms in %s (%s), context %s"),
+	       Event,
+	       Seconds * 1000.0,
+	       *GetNameSafe(Object),
+	       *GetNameSafe(Object ? Object->GetClass() : nullptr),
+	       *GetNameSafe(Context));
+}
+
+template <typename T>
+void UMTaskExecutor::ApplyWatchdog(T& Entry, UObject* Object, EMTaskState& State, double Seconds) const
+{
+	if (Seconds <= Policy.WatchdogThreshold) return;
+	ReportSlowCall(TEXT("OnPoll"), Object, Entry.TaskContext, Seconds);
+
+	Entry.SlowPolls += 1;
+	if (Entry.SlowPolls < Policy.WatchdogStrikes) return;
+
+	switch (Policy.WatchdogAction)
+	{
+	case EMTaskWatchdogAction::Demote:
+		if (!Entry.Demoted)
+		{
+			Entry.Demoted = true;
+			Entry.Priority = EMTaskPriority::Low;
+			UE_LOG(LogMTasks, Warning, TEXT("UMTaskExecutor: Demoted %s after %d slow polls"), *Object->GetName(), Entry.SlowPolls);
+		}
+		break;
+	case EMTaskWatchdogAction::Throttle:
+		{
+			// The schedule was advanced before this poll, so push the next poll out by the new interval now
+			auto& Schedule = Entry.Schedule;
+			Schedule.IntervalTicks = FMath::Clamp(Schedule.IntervalTicks * 2, 2, UMTaskExecutorInternals::MaxThrottleTicks);
+			Schedule.NextPollTick = ElapsedTicks + Schedule.IntervalTicks;
+			if (Schedule.IntervalSeconds > 0)
+			{
+				Schedule.IntervalSeconds = FMath::Max(Schedule.IntervalSeconds, FMath::Min(Schedule.IntervalSeconds * 2, UMTaskExecutorInternals::MaxThrottleSeconds));
+				Schedule.NextPollTime = ElapsedTime + Schedule.IntervalSeconds;
+			}
+			UE_LOG(LogMTasks, Warning, TEXT("UMTaskExecutor: Throttled %s to every %d ticks, %.2f s, after %d slow polls"),
+			       *Object->GetName(), Schedule.IntervalTicks, Schedule.IntervalSeconds, Entry.SlowPolls);
+		}
+		break;
+	case EMTaskWatchdogAction::Reject:
+		UE_LOG(LogMTasks, Warning, TEXT("UMTaskExecutor: Rejected %s after %d slow polls"), *Object->GetName(), Entry.SlowPolls);
+		State = EMTaskState::Rejected;
+		break;
+	default:
+		break;
+	}
+}
+
+void UMTaskExecutor::RequeueDemoted()
+{
+	// Entries only change priority when demoted, so anything out of place belongs in the Low queue.
+	// The queue closes up behind them, so its resume cursor moves back by however many left ahead of it.
+	auto& LowQueue = ReadyQueues[static_cast<int32>(EMTaskPriority::Low)];
+	auto const Requeue = [](auto& Entries, auto& LowEntries, int32& Cursor, int32 Level)
+	{
+		auto Kept = 0;
+		auto KeptBeforeCursor = 0;
+		for (auto i = 0; i < Entries.Num(); i++)
+		{
+			if (static_cast<int32>(Entries[i].Priority) != Level)
+			{
+				LowEntries.Add(Entries[i]);
+				continue;
+			}
+			KeptBeforeCursor += i < Cursor ? 1 : 0;
+			Entries[Kept++] = Entries[i];
+		}
+		Entries.SetNum(Kept, false);
+		Cursor = KeptBeforeCursor;
+	};
+	for (auto Level = static_cast<int32>(EMTaskPriority::Low) + 1; Level < ReadyQueues.Num(); Level++)
+	{
+		auto& Queue = ReadyQueues[Level];
+		Requeue(Queue.Tasks, LowQueue.Tasks, Queue.TaskCursor, Level);
+		Requeue(Queue.Commands, LowQueue.Commands, Queue.CommandCursor, Level);
+	}
+}
+
 void UMTaskExecutor::ApplyExecutionPolicy(const FMTaskExecutorManagedTask& Task) const
 {
-	if (Task.ExecutionDuration > Policy.MaxExecutionDuration)
+	if (Policy.MaxExecutionDuration > 0 && Task.ExecutionDuration > Policy.MaxExecutionDuration)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("Expired MTask which exceeded maximum execution duration: %s"), *Task.Task->GetName())
+		UE_LOG(LogMTasks, Warning, TEXT("Expired MTask which exceeded maximum execution duration: %s"), *Task.Task->GetName())
 		Task.Task->State = EMTaskState::Rejected;
 	}
 }
 
-void UMTaskExecutor::ApplyExecutionPolicy(const FMTaskExecutorManagedCommand& Cmd) const
+void UMTaskExecutor::ApplyExecutionPolicy(FMTaskExecutorManagedCommand& Cmd) const
 {
-	// Maybe in the future we'll need this.
+	if (Cmd.Command->State != EMTaskState::Running) return;
+	const auto& CommandPolicy = Cmd.CommandPolicy;
+
+	if (CommandPolicy.MaxExecutionDuration > 0 && Cmd.ExecutionDuration > CommandPolicy.MaxExecutionDuration)
+	{
+		UE_LOG(LogMTasks, Warning, TEXT("Expired MCommand which exceeded maximum execution duration: %s"), *Cmd.Command->GetName());
+		Cmd.Command->State = EMTaskState::Rejected;
+		return;
+	}
+
+	if (CommandPolicy.LeaseSeconds > 0 && Cmd.SinceRenewed > CommandPolicy.LeaseSeconds)
+	{
+		switch (CommandPolicy.LeaseAction)
+		{
+		case EMTaskLeaseAction::Suspend:
+			UE_LOG(LogMTasks, Display, TEXT("Suspended MCommand which was not renewed for %.1fs: %s"), Cmd.SinceRenewed, *Cmd.Command->GetName());
+			Cmd.Command->Suspended = true;
+			break;
+		default:
+			UE_LOG(LogMTasks, Warning, TEXT("Rejected MCommand which was not renewed for %.1fs: %s"), Cmd.SinceRenewed, *Cmd.Command->GetName());
+			Cmd.Command->State = EMTaskState::Rejected;
+			break;
+		}
+	}
+}
+
+const FMTaskCommandPolicy& UMTaskExecutor::ResolveCommandPolicy(UClass* Class) const
+{
+	if (Policy.CommandPolicies.Num() > 0)
+	{
+		for (auto Super = Class; Super; Super = Super->GetSuperClass())
+		{
+			if (const auto Found = Policy.CommandPolicies.Find(Super))
+			{
+				return *Found;
+			}
+		}
+	}
+	return Policy.CommandPolicy;
 }
 
 bool UMTaskExecutor::ProcessTask(FMTaskExecutorManagedTask& Task, float DeltaTime) const
 {
 	if (Task.Completed) return false;
+	if (Task.Task->CancellationToken && Task.Task->CancellationToken->IsCancelled())
+	{
+		Task.Task->State = EMTaskState::Rejected;
+		Task.Completed = true;
+		return false;
+	}
 	auto const PreviousState = Task.Task->State;
 	Task.ExecutionDuration += DeltaTime;
-	Task.Task->State = Task.Task->OnPoll(DeltaTime);
+	if (Policy.WatchdogThreshold > 0 || ProfileClasses)
+	{
+		auto const PollStart = FPlatformTime::Seconds();
+		Task.Task->State = DispatchOnPoll(Task.Task, DeltaTime);
+		auto const PollTime = FPlatformTime::Seconds() - PollStart;
+		if (ProfileClasses) RecordClassCost(Task.Task, PollTime);
+		if (Policy.WatchdogThreshold > 0) ApplyWatchdog(Task, Task.Task, Task.Task->State, PollTime);
+	}
+	else
+	{
+		Task.Task->State = DispatchOnPoll(Task.Task, DeltaTime);
+	}
+	Task.Task->FlushProgress();
 
-	if (VerboseLogging)
+	if (PreviousState != Task.Task->State)
 	{
-		if (PreviousState != Task.Task->State)
-		{
-			UE_LOG(LogTemp, Display, TEXT("UMTaskExecutor: %d: %s -> %s: %s"),
-			       ElapsedTicks,
-			       *UEnum::GetValueAsString(PreviousState),
-			       *UEnum::GetValueAsString(Task.Task->State),
-			       *Task.Task->GetName());
-		}
+		EventLog.Record(EMTaskEvent::Transition, Task.Task, PreviousState, Task.Task->State, ElapsedTicks, false);
+		MTASKS_TRACE(VerboseLogging, TEXT("UMTaskExecutor: %d: %s -> %s: %s"),
+		             ElapsedTicks,
+		             *UEnum::GetValueAsString(PreviousState),
+		             *UEnum::GetValueAsString(Task.Task->State),
+		             *Task.Task->GetName());
 	}
 
 	// Any custom per-task configurable logic.
@@ -170,9 +761,23 @@ bool UMTaskExecutor::ProcessTask(FMTaskExecutorManagedTask& Task, float DeltaTim
 
 void UMTaskExecutor::ProcessCompletedTask(const FMTaskExecutorManagedTask& Task)
 {
-	// Dispatch events
+	// Dispatch events; the native continuation first, then the multicast delegates only if bound.
+	// Tasks cancelled before admission control started them never get OnEnd.
 	TaskCompletionInProgress = true;
-	Task.Task->OnEnd();
+	if (Task.Started)
+	{
+		auto const EndStart = Policy.WatchdogThreshold > 0 ? FPlatformTime::Seconds() : 0;
+		DispatchOnEnd(Task.Task);
+		if (Policy.WatchdogThreshold > 0)
+		{
+			ReportSlowCall(TEXT("OnEnd"), Task.Task, Task.TaskContext, FPlatformTime::Seconds() - EndStart);
+		}
+	}
+	if (Task.Task->Continuation.IsBound())
+	{
+		Task.Task->Continuation.Execute(Task.Task);
+		Task.Task->Continuation.Unbind();
+	}
 	if (Task.Task->Update.IsBound())
 	{
 		Task.Task->Update.Broadcast(Task.Task);
@@ -187,73 +792,188 @@ void UMTaskExecutor::ProcessCompletedTask(const FMTaskExecutorManagedTask& Task)
 	// Remove parent to prevent memory leaks from circular refs
 	Task.Task->Parent = nullptr;
 
-	// Run child tasks
+	// Run child tasks; children already rejected by a tree cancel are skipped
 	for (const auto& ChildTask : Task.Task->Children)
 	{
 		if (ChildTask.Type == Task.Task->State)
 		{
-			if (ChildTask.Child.IsValid())
+			if (ChildTask.Child.IsValid() && ChildTask.Child->IsPending())
 			{
+				if (!ChildTask.Child->CancellationToken)
+				{
+					ChildTask.Child->CancellationToken = Task.Task->CancellationToken;
+				}
+				EventLog.Record(EMTaskEvent::Promoted, ChildTask.Child.Get(), EMTaskState::Idle, Task.Task->State, ElapsedTicks, false, Task.Task);
 				RunTask(ChildTask.Child.Get(), Task.TaskContext);
 			}
 		}
 	}
 
-	if (VerboseLogging)
+	// The branch not taken is expected, not an orphan; with Collect it is released without being reported.
+	// Promoted children are no longer pending, so a child on both branches is left alone.
+	if (Policy.OrphanAction == EMTaskOrphanAction::Collect)
 	{
-		UE_LOG(LogTemp, Display, TEXT("UMTaskExecutor: %d: %s: %s"), ElapsedTicks, *UEnum::GetValueAsString(Task.Task->State),
-		       *Task.Task->GetName());
+		for (const auto& ChildTask : Task.Task->Children)
+		{
+			if (ChildTask.Type != Task.Task->State && ChildTask.Child.IsValid() && ChildTask.Child->IsPending())
+			{
+				RejectOrphanTree(ChildTask.Child.Get());
+			}
+		}
 	}
 
+	EventLog.Record(EMTaskEvent::Completed, Task.Task, Task.Task->State, Task.Task->State, ElapsedTicks, false);
+	MTASKS_TRACE(VerboseLogging, TEXT("UMTaskExecutor: %d: %s: %s"), ElapsedTicks, *UEnum::GetValueAsString(Task.Task->State),
+	             *Task.Task->GetName());
+
 	TaskCompletionInProgress = false;
 }
 
-void UMTaskExecutor::ProcessTasks(float DeltaTime)
+template <typename T>
+const FMTaskScriptOverrides& UMTaskExecutor::GetScriptOverrides(const T* Object) const
 {
-	// Add any pending tasks to the running tasks
-	RunningTasks.Append(PendingTasks);
-	PendingTasks.Reset();
+	const auto Class = Object->GetClass();
+	if (const auto Cached = ScriptOverrides.Find(Class))
+	{
+		return *Cached;
+	}
+
+	FMTaskScriptOverrides Overrides;
+	Overrides.OnStart = Class->IsFunctionImplementedInScript(GET_FUNCTION_NAME_CHECKED(T, OnStart));
+	Overrides.OnPoll = Class->IsFunctionImplementedInScript(GET_FUNCTION_NAME_CHECKED(T, OnPoll));
+	Overrides.OnEnd = Class->IsFunctionImplementedInScript(GET_FUNCTION_NAME_CHECKED(T, OnEnd));
+	return ScriptOverrides.Add(Class, Overrides);
+}
+
+template <typename T>
+void UMTaskExecutor::DispatchOnStart(T* Object, UObject* Context) const
+{
+	if (GetScriptOverrides(Object).OnStart)
+	{
+		Object->OnStart(Context);
+	}
+	else
+	{
+		Object->OnStart_Implementation(Context);
+	}
+}
+
+template <typename T>
+EMTaskState UMTaskExecutor::DispatchOnPoll(T* Object, float DeltaTime) const
+{
+	if (GetScriptOverrides(Object).OnPoll)
+	{
+		return Object->OnPoll(DeltaTime);
+	}
+	return Object->OnPoll_Implementation(DeltaTime);
+}
+
+template <typename T>
+void UMTaskExecutor::DispatchOnEnd(T* Object) const
+{
+	if (GetScriptOverrides(Object).OnEnd)
+	{
+		Object->OnEnd();
+	}
+	else
+	{
+		Object->OnEnd_Implementation();
+	}
+}
+
+void UMTaskExecutor::ProcessTasks(FMTaskExecutorReadyQueue& Queue, float DeltaTime, bool IsBudgeted)
+{
+	auto& Tasks = Queue.Tasks;
+	auto const Count = Tasks.Num();
+	auto const First = Count > 0 ? Queue.TaskCursor % Count : 0;
 
-	// Process existing tasks
-	for (auto& T : RunningTasks)
+	// Process existing tasks, starting from wherever the last tick ran out of budget.
+	UMTask* ResumeFrom = nullptr;
+	auto Guaranteed = Policy.MinPollsPerLevel;
+	for (auto i = 0; i < Count; i++)
 	{
-		if (VerboseLogging)
+		auto& T = Tasks[(First + i) % Count];
+		if (!T.Completed)
 		{
-			if (T.ExecutionDuration == 0)
+			if (!IsPollDue(T.Schedule))
+			{
+				T.DeferredDeltaTime += DeltaTime;
+				continue;
+			}
+			if ((IsBudgeted || T.Demoted) && IsStrideSkipped(T.Schedule))
+			{
+				T.DeferredDeltaTime += DeltaTime;
+				Stats.Deferred += 1;
+				continue;
+			}
+			if ((IsBudgeted || T.Demoted) && IsOverBudget() && Guaranteed <= 0)
 			{
-				UE_LOG(LogTemp, Display, TEXT("UMTaskExecutor: %d: Process: %s"), ElapsedTicks, *T.Task->GetName());
+				if (!ResumeFrom) ResumeFrom = T.Task;
+				T.DeferredDeltaTime += DeltaTime;
+				Stats.Deferred += 1;
+				continue;
 			}
+			Guaranteed -= 1;
+			AdvanceSchedule(T.Schedule);
+			Stats.Polled += 1;
 		}
-		if (!ProcessTask(T, DeltaTime))
+		MTASKS_TRACE(VerboseLogging && T.ExecutionDuration == 0, TEXT("UMTaskExecutor: %d: Process: %s"), ElapsedTicks, *T.Task->GetName());
+		auto const EffectiveDeltaTime = DeltaTime + T.DeferredDeltaTime;
+		T.DeferredDeltaTime = 0;
+		if (!ProcessTask(T, EffectiveDeltaTime))
 		{
 			ProcessCompletedTask(T);
 		}
 	}
 
 	// Prune any completed tasks
-	RunningTasks.RemoveAll(UMTaskExecutor::IsTaskCompletedPredicate);
+	Tasks.RemoveAll(UMTaskExecutor::IsTaskCompletedPredicate);
+	Queue.TaskCursor = 0;
+	if (ResumeFrom)
+	{
+		Queue.TaskCursor = FMath::Max(0, Tasks.IndexOfByPredicate([&](const FMTaskExecutorManagedTask& T)
+		{
+			return T.Task == ResumeFrom;
+		}));
+	}
 }
 
 bool UMTaskExecutor::ProcessCommand(FMTaskExecutorManagedCommand& Cmd, float DeltaTime) const
 {
 	if (Cmd.Completed) return false;
+	if (Cmd.Command->CancellationToken && Cmd.Command->CancellationToken->IsCancelled())
+	{
+		Cmd.Command->State = EMTaskState::Rejected;
+		Cmd.Completed = true;
+		return false;
+	}
 	auto const PreviousState = Cmd.Command->State;
 	Cmd.ExecutionDuration += DeltaTime;
-	Cmd.Command->State = Cmd.Command->OnPoll(DeltaTime);
+	if (Policy.WatchdogThreshold > 0 || ProfileClasses)
+	{
+		auto const PollStart = FPlatformTime::Seconds();
+		Cmd.Command->State = DispatchOnPoll(Cmd.Command, DeltaTime);
+		auto const PollTime = FPlatformTime::Seconds() - PollStart;
+		if (ProfileClasses) RecordClassCost(Cmd.Command, PollTime);
+		if (Policy.WatchdogThreshold > 0) ApplyWatchdog(Cmd, Cmd.Command, Cmd.Command->State, PollTime);
+	}
+	else
+	{
+		Cmd.Command->State = DispatchOnPoll(Cmd.Command, DeltaTime);
+	}
 
-	if (VerboseLogging)
+	if (PreviousState != Cmd.Command->State)
 	{
-		if (PreviousState != Cmd.Command->State)
-		{
-			UE_LOG(LogTemp, Display, TEXT("UMTaskExecutor: %d: %s -> %s: %s"),
-			       ElapsedTicks,
-			       *UEnum::GetValueAsString(PreviousState),
-			       *UEnum::GetValueAsString(Cmd.Command->State),
-			       *Cmd.Command->GetName());
-		}
+		EventLog.Record(EMTaskEvent::Transition, Cmd.Command, PreviousState, Cmd.Command->State, ElapsedTicks, true);
+		MTASKS_TRACE(VerboseLogging, TEXT("UMTaskExecutor: %d: %s -> %s: %s"),
+		             ElapsedTicks,
+		             *UEnum::GetValueAsString(PreviousState),
+		             *UEnum::GetValueAsString(Cmd.Command->State),
+		             *Cmd.Command->GetName());
 	}
 
-	// Any custom per-task configurable logic.
+	// Any custom per-command configurable logic; leases count polled time since the last renewal
+	Cmd.SinceRenewed = Cmd.Command->ConsumeRenewal() ? 0 : Cmd.SinceRenewed + DeltaTime;
 	ApplyExecutionPolicy(Cmd);
 
 	Cmd.Completed = Cmd.Command->State != EMTaskState::Running;
@@ -262,9 +982,17 @@ bool UMTaskExecutor::ProcessCommand(FMTaskExecutorManagedCommand& Cmd, float Del
 
 void UMTaskExecutor::ProcessCompletedCommand(const FMTaskExecutorManagedCommand& Cmd)
 {
-	// Dispatch events
+	// Dispatch events; commands cancelled before admission control started them never get OnEnd.
 	TaskCompletionInProgress = true;
-	Cmd.Command->OnEnd();
+	if (Cmd.Started)
+	{
+		auto const EndStart = Policy.WatchdogThreshold > 0 ? FPlatformTime::Seconds() : 0;
+		DispatchOnEnd(Cmd.Command);
+		if (Policy.WatchdogThreshold > 0)
+		{
+			ReportSlowCall(TEXT("OnEnd"), Cmd.Command, Cmd.TaskContext, FPlatformTime::Seconds() - EndStart);
+		}
+	}
 	if (Cmd.Command->Update.IsBound())
 	{
 		Cmd.Command->Update.Broadcast(Cmd.Command);
@@ -279,39 +1007,163 @@ void UMTaskExecutor::ProcessCompletedCommand(const FMTaskExecutorManagedCommand&
 	// Remove parent to prevent memory leaks from circular refs
 	Cmd.Command->Parent = nullptr;
 
-	if (VerboseLogging)
-	{
-		UE_LOG(LogTemp, Display, TEXT("UMTaskExecutor: %d: %s: %s"), ElapsedTicks, *UEnum::GetValueAsString(Cmd.Command->State),
-		       *Cmd.Command->GetName());
-	}
+	EventLog.Record(EMTaskEvent::Completed, Cmd.Command, Cmd.Command->State, Cmd.Command->State, ElapsedTicks, true);
+	MTASKS_TRACE(VerboseLogging, TEXT("UMTaskExecutor: %d: %s: %s"), ElapsedTicks, *UEnum::GetValueAsString(Cmd.Command->State),
+	             *Cmd.Command->GetName());
 
 	TaskCompletionInProgress = false;
 }
 
-void UMTaskExecutor::ProcessCommands(float DeltaTime)
+void UMTaskExecutor::ProcessCommands(FMTaskExecutorReadyQueue& Queue, float DeltaTime, bool IsBudgeted)
 {
-	// Add any pending commands to the running commands
-	RunningCommands.Append(PendingCommands);
-	PendingCommands.Reset();
+	auto& Commands = Queue.Commands;
+	auto const Count = Commands.Num();
+	auto const First = Count > 0 ? Queue.CommandCursor % Count : 0;
 
-	// Process existing tasks
-	for (auto& C : RunningCommands)
+	// Process existing commands, starting from wherever the last tick ran out of budget.
+	UMCommand* ResumeFrom = nullptr;
+	auto Guaranteed = Policy.MinPollsPerLevel;
+	for (auto i = 0; i < Count; i++)
 	{
-		if (VerboseLogging)
+		auto& C = Commands[(First + i) % Count];
+		if (!C.Completed)
 		{
-			if (C.ExecutionDuration == 0)
+			if (C.Command->Suspended) continue;
+			if (!IsPollDue(C.Schedule))
 			{
-				UE_LOG(LogTemp, Display, TEXT("UMTaskExecutor: %d: Process: %s"), ElapsedTicks, *C.Command->GetName());
+				C.DeferredDeltaTime += DeltaTime;
+				continue;
 			}
+			if ((IsBudgeted || C.Demoted) && IsStrideSkipped(C.Schedule))
+			{
+				C.DeferredDeltaTime += DeltaTime;
+				Stats.Deferred += 1;
+				continue;
+			}
+			if ((IsBudgeted || C.Demoted) && IsOverBudget() && Guaranteed <= 0)
+			{
+				if (!ResumeFrom) ResumeFrom = C.Command;
+				C.DeferredDeltaTime += DeltaTime;
+				Stats.Deferred += 1;
+				continue;
+			}
+			Guaranteed -= 1;
+			AdvanceSchedule(C.Schedule);
+			Stats.Polled += 1;
 		}
-		if (!ProcessCommand(C, DeltaTime))
+		MTASKS_TRACE(VerboseLogging && C.ExecutionDuration == 0, TEXT("UMTaskExecutor: %d: Process: %s"), ElapsedTicks, *C.Command->GetName());
+		auto const EffectiveDeltaTime = DeltaTime + C.DeferredDeltaTime;
+		C.DeferredDeltaTime = 0;
+		if (!ProcessCommand(C, EffectiveDeltaTime))
 		{
 			ProcessCompletedCommand(C);
 		}
 	}
 
-	// Prune any completed tasks
-	RunningCommands.RemoveAll(UMTaskExecutor::IsCommandCompletedPredicate);
+	// Prune any completed commands, and move suspended ones out of the way
+	for (const auto& C : Commands)
+	{
+		if (!C.Completed && C.Command->Suspended) SuspendedCommands.Add(C);
+	}
+	Commands.RemoveAll([](const FMTaskExecutorManagedCommand& C)
+	{
+		return C.Completed || C.Command->Suspended;
+	});
+	Queue.CommandCursor = 0;
+	if (ResumeFrom)
+	{
+		Queue.CommandCursor = FMath::Max(0, Commands.IndexOfByPredicate([&](const FMTaskExecutorManagedCommand& C)
+		{
+			return C.Command == ResumeFrom;
+		}));
+	}
+}
+
+void UMTaskExecutor::AdmitPending()
+{
+	if (ReadyQueues.Num() != PriorityLevels)
+	{
+		ReadyQueues.SetNum(PriorityLevels);
+	}
+
+	// Starting an entry may run others, which are added to the pending lists; so admit from a copy,
+	// and put anything over the MaxStartsPerTick cap back at the front for the next tick.
+	auto StartsRemaining = Stats.EffectiveMaxStartsPerTick > 0 ? Stats.EffectiveMaxStartsPerTick : MAX_int32;
+
+	auto AdmittingTasks = MoveTemp(PendingTasks);
+	PendingTasks.Reset();
+	TArray<FMTaskExecutorManagedTask> DeferredTasks;
+	for (auto& T : AdmittingTasks)
+	{
+		if (!T.Started && !T.Completed)
+		{
+			if (StartsRemaining <= 0)
+			{
+				DeferredTasks.Add(T);
+				continue;
+			}
+			StartsRemaining -= 1;
+			Stats.Started += 1;
+			StartManagedTask(T);
+		}
+
+		// Cancelled while queued, or from inside OnStart
+		if (!T.Task->IsRunning())
+		{
+			T.Completed = true;
+		}
+
+		auto& Entry = ReadyQueues[static_cast<int32>(T.Priority)].Tasks.Add_GetRef(T);
+		StaggerSchedule(Entry.Schedule);
+		SpreadFirstPoll(Entry.Schedule);
+	}
+	PendingTasks.Insert(DeferredTasks, 0);
+
+	auto AdmittingCommands = MoveTemp(PendingCommands);
+	PendingCommands.Reset();
+	TArray<FMTaskExecutorManagedCommand> DeferredCommands;
+	for (auto& C : AdmittingCommands)
+	{
+		// Suspended while queued; it is started, if need be, when it is resumed
+		if (!C.Completed && C.Command->Suspended)
+		{
+			SuspendedCommands.Add(C);
+			continue;
+		}
+
+		if (!C.Started && !C.Completed)
+		{
+			if (StartsRemaining <= 0)
+			{
+				DeferredCommands.Add(C);
+				continue;
+			}
+			StartsRemaining -= 1;
+			Stats.Started += 1;
+			StartManagedCommand(C);
+		}
+
+		// Cancelled while queued, or from inside OnStart
+		if (!C.Command->IsRunning())
+		{
+			C.Completed = true;
+		}
+
+		auto& Entry = ReadyQueues[static_cast<int32>(C.Priority)].Commands.Add_GetRef(C);
+		StaggerSchedule(Entry.Schedule);
+		SpreadFirstPoll(Entry.Schedule);
+	}
+	PendingCommands.Insert(DeferredCommands, 0);
+}
+
+bool UMTaskExecutor::IsOverBudget() const
+{
+	return Stats.EffectiveTickBudget > 0 && GetBudgetTime() - TickStartTime > Stats.EffectiveTickBudget;
+}
+
+double UMTaskExecutor::GetBudgetTime() const
+{
+	return BudgetClock ? BudgetClock() : FPlatformTime::Seconds();
 }
 
 bool UMTaskExecutor::IsTaskCompletedPredicate(const FMTaskExecutorManagedTask& Task)
@@ -324,17 +1176,238 @@ bool UMTaskExecutor::IsCommandCompletedPredicate(const FMTaskExecutorManagedComm
 	return Cmd.Completed;
 }
 
+void UMTaskExecutor::StaggerSchedule(FMTaskExecutorSchedule& Schedule)
+{
+	Schedule.NextPollTick = ElapsedTicks;
+	Schedule.NextPollTime = ElapsedTime;
+	Schedule.StrideSlot = StrideCounter++;
+	if (!Schedule.IsThrottled()) return;
+
+	// Ticks are spread round robin over the interval; seconds over a golden ratio sequence,
+	// which stays evenly distributed however many entries are admitted.
+	StaggerCounter += 1;
+	if (Schedule.IntervalTicks > 1)
+	{
+		Schedule.NextPollTick += StaggerCounter % Schedule.IntervalTicks;
+	}
+	if (Schedule.IntervalSeconds > 0)
+	{
+		Schedule.NextPollTime += Schedule.IntervalSeconds * FMath::Frac(StaggerCounter * 0.6180339887);
+	}
+}
+
+void UMTaskExecutor::SpreadFirstPoll(FMTaskExecutorSchedule& Schedule)
+{
+	if (Policy.SpreadFirstPollTicks <= 1) return;
+	AdmittedCount += 1;
+	Schedule.NextPollTick = FMath::Max<int64>(Schedule.NextPollTick, ElapsedTicks + AdmittedCount % Policy.SpreadFirstPollTicks);
+}
+
+bool UMTaskExecutor::IsPollDue(const FMTaskExecutorSchedule& Schedule) const
+{
+	return ElapsedTicks >= Schedule.NextPollTick && ElapsedTime >= Schedule.NextPollTime;
+}
+
+void UMTaskExecutor::AdvanceSchedule(FMTaskExecutorSchedule& Schedule) const
+{
+	if (!Schedule.IsThrottled()) return;
+
+	if (Schedule.IntervalTicks > 1)
+	{
+		Schedule.NextPollTick += Schedule.IntervalTicks;
+		if (Schedule.NextPollTick <= ElapsedTicks)
+		{
+			Schedule.NextPollTick = ElapsedTicks + Schedule.IntervalTicks;
+		}
+	}
+	if (Schedule.IntervalSeconds > 0)
+	{
+		Schedule.NextPollTime += Schedule.IntervalSeconds;
+		if (Schedule.NextPollTime <= ElapsedTime)
+		{
+			Schedule.NextPollTime = ElapsedTime + Schedule.IntervalSeconds;
+		}
+	}
+}
+
+FMTaskExecutorMemory UMTaskExecutor::GetMemoryUsage() const
+{
+	FMTaskExecutorMemory Memory;
+	Memory.ReadyQueues = ReadyQueues.GetAllocatedSize();
+	for (const auto& Queue : ReadyQueues)
+	{
+		Memory.ReadyQueues += Queue.Tasks.GetAllocatedSize() + Queue.Commands.GetAllocatedSize();
+	}
+	Memory.Pending = PendingTasks.GetAllocatedSize() + PendingCommands.GetAllocatedSize();
+	Memory.Suspended = SuspendedCommands.GetAllocatedSize();
+	Memory.EventLog = EventLog.GetAllocatedSize();
+	Memory.Caches = ScriptOverrides.GetAllocatedSize()
+		+ ClassCosts.GetAllocatedSize()
+		+ FrameTimes.GetAllocatedSize()
+		+ QueryCache.GetAllocatedSize();
+	return Memory;
+}
+
+void UMTaskExecutor::GetClassFootprints(TMap<UClass*, FMTaskClassFootprint>& OutFootprints) const
+{
+	const auto Add = [&](const UObject* Object, SIZE_T ChildrenBytes, SIZE_T DelegateBytes, float Age)
+	{
+		auto& Footprint = OutFootprints.FindOrAdd(Object->GetClass());
+		Footprint.Count += 1;
+		Footprint.ObjectBytes += Object->GetClass()->GetStructureSize();
+		Footprint.ChildrenBytes += ChildrenBytes;
+		Footprint.DelegateBytes += DelegateBytes;
+		Footprint.OldestSeconds = FMath::Max(Footprint.OldestSeconds, Age);
+	};
+	ForEachTask([&](const FMTaskExecutorManagedTask& T)
+	{
+		Add(T.Task, T.Task->Children.GetAllocatedSize(), T.Task->GetDelegatesAllocatedSize(), T.ExecutionDuration);
+	});
+	ForEachCommand([&](const FMTaskExecutorManagedCommand& C)
+	{
+		Add(C.Command, 0, C.Command->GetDelegatesAllocatedSize(), C.ExecutionDuration);
+	});
+}
+
+void UMTaskExecutor::GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize)
+{
+	Super::GetResourceSizeEx(CumulativeResourceSize);
+	CumulativeResourceSize.AddDedicatedSystemMemoryBytes(GetMemoryUsage().GetTotal());
+}
+
+void UMTaskExecutor::UpdateMemoryStat()
+{
+#if STATS
+	const auto Memory = GetMemoryUsage().GetTotal();
+	INC_MEMORY_STAT_BY(STAT_MTasksExecutorMemory, Memory);
+	DEC_MEMORY_STAT_BY(STAT_MTasksExecutorMemory, ReportedMemory);
+	ReportedMemory = Memory;
+#endif
+}
+
+void UMTaskExecutor::BeginDestroy()
+{
+#if STATS
+	DEC_MEMORY_STAT_BY(STAT_MTasksExecutorMemory, ReportedMemory);
+	ReportedMemory = 0;
+#endif
+	Super::BeginDestroy();
+}
+
 void UMTaskExecutor::Initialize(FMTaskExecutorPolicy InPolicy, bool InActive)
 {
 	Policy = InPolicy;
 	SetActive(InActive);
+	FrameTimes.Reset();
+	FrameTimeCursor = 0;
+	Stats = FMTaskExecutorStats();
+	EventLog.SetCapacity(Policy.EventLogSize);
 	TaskCompletionInProgress = false;
+	ReadyQueues.SetNum(PriorityLevels);
 }
 
 void UMTaskExecutor::Tick(float DeltaTime)
+{
+	TickWithFrameTime(DeltaTime, FApp::GetDeltaTime());
+}
+
+void UMTaskExecutor::TickWithFrameTime(float DeltaTime, float FrameTime)
 {
 	if (!IsActive) return;
-	ProcessTasks(DeltaTime);
-	ProcessCommands(DeltaTime);
+	TickStartTime = GetBudgetTime();
+	ElapsedTime += DeltaTime;
+	QueryCache.Reset();
+	EventLog.SetCapacity(Policy.EventLogSize);
+	UpdateAdaptivePolicy(FrameTime);
+
+	if (Policy.OrphanAction != EMTaskOrphanAction::None && ElapsedTime >= NextOrphanScan)
+	{
+		NextOrphanScan = ElapsedTime + Policy.OrphanScanInterval;
+		ScanForOrphans(Policy.OrphanAction == EMTaskOrphanAction::Collect);
+	}
+
+	// Add any pending tasks and commands to the ready queues
+	AdmitPending();
+
+	// Highest priority first, so whatever is deferred when the budget runs out is the least important
+	auto const AlwaysPollLevel = static_cast<int32>(Policy.AlwaysPollPriority);
+	for (auto Level = ReadyQueues.Num() - 1; Level >= 0; Level--)
+	{
+		auto const IsBudgeted = Level < AlwaysPollLevel;
+		ProcessTasks(ReadyQueues[Level], DeltaTime, IsBudgeted);
+		ProcessCommands(ReadyQueues[Level], DeltaTime, IsBudgeted);
+	}
+	RequeueDemoted();
+
+	INC_DWORD_STAT_BY(STAT_MTasksPolled, Stats.Polled);
+	INC_DWORD_STAT_BY(STAT_MTasksDeferred, Stats.Deferred);
+	INC_DWORD_STAT_BY(STAT_MTasksStarted, Stats.Started);
+	SET_FLOAT_STAT(STAT_MTasksThrottleScale, Stats.ThrottleScale);
+	SET_DWORD_STAT(STAT_MTasksLowPriorityStride, Stats.LowPriorityStride);
+	UpdateMemoryStat();
+
+	Stats.TickTime = FPlatformTime::Seconds() - TickStartTime;
+
 	ElapsedTicks += 1;
 }
+
+void UMTaskExecutor::UpdateAdaptivePolicy(float FrameTime)
+{
+	using namespace UMTaskExecutorInternals;
+	Stats.Polled = 0;
+	Stats.Deferred = 0;
+	Stats.Started = 0;
+
+	if (!Policy.Adaptive || Policy.TargetFrameTime <= 0)
+	{
+		Stats.AverageFrameTime = 0;
+		Stats.ThrottleScale = 1;
+		Stats.LowPriorityStride = 1;
+		Stats.EffectiveTickBudget = Policy.TickBudget;
+		Stats.EffectiveMaxStartsPerTick = Policy.MaxStartsPerTick;
+		return;
+	}
+
+	if (FrameTimes.Num() < FrameHistory)
+	{
+		FrameTimes.Add(FrameTime);
+	}
+	else
+	{
+		FrameTimes[FrameTimeCursor] = FrameTime;
+		FrameTimeCursor = (FrameTimeCursor + 1) % FrameHistory;
+	}
+
+	auto Total = 0.0f;
+	for (const auto Time : FrameTimes)
+	{
+		Total += Time;
+	}
+	Stats.AverageFrameTime = Total / FrameTimes.Num();
+
+	// Back off quickly when over target, recover slowly with headroom
+	if (ElapsedTicks % AdaptInterval == 0)
+	{
+		if (Stats.AverageFrameTime > Policy.TargetFrameTime)
+		{
+			Stats.ThrottleScale *= AdaptBackoff;
+		}
+		else if (Stats.AverageFrameTime < Policy.TargetFrameTime * AdaptHeadroom)
+		{
+			Stats.ThrottleScale += AdaptRecoverStep;
+		}
+		Stats.ThrottleScale = FMath::Clamp(Stats.ThrottleScale, FMath::Clamp(Policy.AdaptiveMinScale, 0.01f, 1.0f), 1.0f);
+	}
+
+	Stats.LowPriorityStride = FMath::CeilToInt(1.0f / Stats.ThrottleScale);
+	Stats.EffectiveTickBudget = Policy.TickBudget * Stats.ThrottleScale;
+	Stats.EffectiveMaxStartsPerTick = Policy.MaxStartsPerTick > 0
+		                                  ? FMath::Max(1, FMath::RoundToInt(Policy.MaxStartsPerTick * Stats.ThrottleScale))
+		                                  : 0;
+}
+
+bool UMTaskExecutor::IsStrideSkipped(const FMTaskExecutorSchedule& Schedule) const
+{
+	if (Stats.LowPriorityStride <= 1) return false;
+	return (ElapsedTicks + Schedule.StrideSlot) % Stats.LowPriorityStride != 0;
+}
@@ -34,3 +34,44 @@ UMTask* UMTask::Then(EMTaskState OnState, UMTask* Child)
 void UMTask::OnEnd_Implementation()
 {
 }
+
+SIZE_T UMTask::GetDelegatesAllocatedSize() const
+{
+	return OnUpdate.GetAllocatedSize() + Update.GetAllocatedSize() + Continuation.GetAllocatedSize()
+		+ OnProgress.GetAllocatedSize() + ProgressUpdate.GetAllocatedSize();
+}
+
+void UMTask::GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize)
+{
+	Super::GetResourceSizeEx(CumulativeResourceSize);
+	CumulativeResourceSize.AddDedicatedSystemMemoryBytes(Children.GetAllocatedSize() + GetDelegatesAllocatedSize());
+}
+
+void UMTask::SetProgress(float InProgress)
+{
+	InProgress = FMath::Clamp(InProgress, 0.0f, 1.0f);
+	if (InProgress == Progress) return;
+	Progress = InProgress;
+	ProgressDirty = true;
+}
+
+void UMTask::FlushProgress()
+{
+	if (!ProgressDirty) return;
+	ProgressDirty = false;
+
+	if (ProgressUpdate.IsBound())
+	{
+		ProgressUpdate.Broadcast(this, Progress);
+	}
+	if (OnProgress.IsBound())
+	{
+		OnProgress.Broadcast(this, Progress);
+	}
+}
+
+FMTaskQueryCache* UMTask::GetQueryCache() const
+{
+	const auto Executor = OwningExecutor.Get();
+	return Executor ? &Executor->GetQueryCache() : nullptr;
+}
@@ -0,0 +1,229 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "MTaskEventLog.h"
+#include "MTaskNames.h"
+#include "UObject/UObjectArray.h"
+
+namespace FMTaskEventLogInternals
+{
+	const TCHAR* KindName(EMTaskEvent Kind)
+	{
+		switch (Kind)
+		{
+		case EMTaskEvent::Queued:
+			return TEXT("Queued");
+		case EMTaskEvent::Started:
+			return TEXT("Started");
+		case EMTaskEvent::Transition:
+			return TEXT("Transition");
+		case EMTaskEvent::Completed:
+			return TEXT("Completed");
+		case EMTaskEvent::Cancelled:
+			return TEXT("Cancelled");
+		case EMTaskEvent::Promoted:
+			return TEXT("Promoted");
+		default:
+			return TEXT("Unknown");
+		}
+	}
+
+	/** Best effort; the slot may have been reused by another object since the event */
+	FString ObjectName(uint32 ObjectId)
+	{
+		const auto Item = GUObjectArray.IndexToObject(ObjectId);
+		const auto Object = Item ? static_cast<UObject*>(Item->Object) : nullptr;
+		return Object ? Object->GetName() : FString(TEXT("<gone>"));
+	}
+
+	FString JsonEscape(const FString& Value)
+	{
+		return Value.Replace(TEXT("\\"), TEXT("\\\\")).Replace(TEXT("\""), TEXT("\\\""));
+	}
+
+	/** Microseconds since Origin; the unit Chrome traces use */
+	double Micros(uint64 Cycles, uint64 Origin)
+	{
+		return FPlatformTime::ToSeconds64(Cycles - Origin) * 1000000.0;
+	}
+}
+
+void FMTaskEventLog::SetCapacity(int32 InCapacity)
+{
+	InCapacity = FMath::Max(InCapacity, 0);
+	if (InCapacity == RequestedCapacity) return;
+	RequestedCapacity = InCapacity;
+
+	Slots.Reset();
+	Slots.SetNum(InCapacity > 0 ? FMath::RoundUpToPowerOfTwo(InCapacity) : 0);
+	Head = 0;
+}
+
+void FMTaskEventLog::ForEach(TFunctionRef<void(const FMTaskEvent&)> Visitor) const
+{
+	const auto Capacity = Slots.Num();
+	if (Capacity == 0) return;
+
+	const auto End = FPlatformAtomics::AtomicRead(&Head);
+	for (auto Ticket = FMath::Max<int64>(End - Capacity, 0); Ticket < End; Ticket++)
+	{
+		const auto& Slot = Slots[Ticket & (Capacity - 1)];
+		if (FPlatformAtomics::AtomicRead(&Slot.Sequence) != Ticket + 1) continue;
+
+		FPlatformMisc::MemoryBarrier();
+		const auto Event = Slot.Event;
+		FPlatformMisc::MemoryBarrier();
+
+		// Overwritten while we were copying it
+		if (FPlatformAtomics::AtomicRead(&Slot.Sequence) != Ticket + 1) continue;
+		Visitor(Event);
+	}
+}
+
+void FMTaskEventLog::Dump(FOutputDevice& Out) const
+{
+	using namespace FMTaskEventLogInternals;
+	Out.Logf(TEXT("MTasks event log: %d events"), Num());
+
+	uint64 Origin = 0;
+	ForEach([&](const FMTaskEvent& Event)
+	{
+		Origin = Origin ? Origin : Event.Cycles;
+		Out.Logf(TEXT("  %lld (%.3f ms): %s %s %s (#%u): %s -> %s"),
+		         Event.Tick,
+		         Micros(Event.Cycles, Origin) / 1000.0,
+		         KindName(Event.Kind),
+		         Event.IsCommand ? TEXT("command") : TEXT("task"),
+		         *ObjectName(Event.ObjectId),
+		         Event.ObjectId,
+		         *MTaskNames::ValueName(Event.From),
+		         *MTaskNames::ValueName(Event.To));
+	});
+}
+
+FString FMTaskEventLog::ToChromeTrace() const
+{
+	using namespace FMTaskEventLogInternals;
+
+	FString Out = TEXT("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+	auto First = true;
+	const auto Append = [&](const FString& Line)
+	{
+		Out += First ? TEXT("") : TEXT(",\n");
+		Out += Line;
+		First = false;
+	};
+
+	uint64 Origin = 0;
+	uint64 Last = 0;
+	TMap<uint32, uint64> OpenSpans;
+	TMap<uint32, FString> Names;
+	auto FlowId = 0;
+
+	ForEach([&](const FMTaskEvent& Event)
+	{
+		Origin = Origin ? Origin : Event.Cycles;
+		Last = Event.Cycles;
+		const auto Ts = Micros(Event.Cycles, Origin);
+
+		auto* Name = Names.Find(Event.ObjectId);
+		if (!Name)
+		{
+			Name = &Names.Add(Event.ObjectId, JsonEscape(ObjectName(Event.ObjectId)));
+			Append(FString::Printf(TEXT("{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":0,\"tid\":%u,\"args\":{\"name\":\"%s %s\"}}"),
+			                       Event.ObjectId,
+			                       *JsonEscape(ObjectName(Event.ClassId)),
+			                       **Name));
+		}
+
+		switch (Event.Kind)
+		{
+		case EMTaskEvent::Started:
+			OpenSpans.Add(Event.ObjectId, Event.Cycles);
+			break;
+
+		case EMTaskEvent::Completed:
+		case EMTaskEvent::Cancelled:
+			{
+				uint64 Started;
+				if (OpenSpans.RemoveAndCopyValue(Event.ObjectId, Started))
+				{
+					Append(FString::Printf(
+						TEXT("{\"ph\":\"X\",\"name\":\"%s\",\"cat\":\"%s\",\"pid\":0,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"state\":\"%s\"}}"),
+						*JsonEscape(ObjectName(Event.ClassId)),
+						Event.IsCommand ? TEXT("command") : TEXT("task"),
+						Event.ObjectId,
+						Micros(Started, Origin),
+						Micros(Event.Cycles, Started),
+						*MTaskNames::ValueName(Event.To)));
+				}
+			}
+			break;
+
+		case EMTaskEvent::Promoted:
+			FlowId += 1;
+			Append(FString::Printf(TEXT("{\"ph\":\"s\",\"name\":\"Then\",\"cat\":\"promotion\",\"id\":%d,\"pid\":0,\"tid\":%u,\"ts\":%.3f}"),
+			                       FlowId, Event.RelatedId, Ts));
+			Append(FString::Printf(TEXT("{\"ph\":\"f\",\"bp\":\"e\",\"name\":\"Then\",\"cat\":\"promotion\",\"id\":%d,\"pid\":0,\"tid\":%u,\"ts\":%.3f}"),
+			                       FlowId, Event.ObjectId, Ts));
+			break;
+
+		default:
+			break;
+		}
+
+		Append(FString::Printf(
+			TEXT("{\"ph\":\"i\",\"s\":\"t\",\"name\":\"%s %s -> %s\",\"pid\":0,\"tid\":%u,\"ts\":%.3f,\"args\":{\"tick\":%lld}}"),
+			KindName(Event.Kind),
+			*MTaskNames::ValueName(Event.From),
+			*MTaskNames::ValueName(Event.To),
+			Event.ObjectId,
+			Ts,
+			Event.Tick));
+	});
+
+	// Anything still running when the log was exported runs to the end of the trace
+	for (const auto& Open : OpenSpans)
+	{
+		Append(FString::Printf(TEXT("{\"ph\":\"X\",\"name\":\"%s\",\"pid\":0,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"state\":\"Open\"}}"),
+		                       *Names.FindChecked(Open.Key),
+		                       Open.Key,
+		                       Micros(Open.Value, Origin),
+		                       Micros(Last, Open.Value)));
+	}
+
+	Out += TEXT("\n]}\n");
+	return Out;
+}
+
+FString FMTaskEventLog::ToCsv() const
+{
+	using namespace FMTaskEventLogInternals;
+
+	FString Out = TEXT("Tick,Milliseconds,Event,Type,Id,Class,Name,From,To,Related\n");
+	uint64 Origin = 0;
+	ForEach([&](const FMTaskEvent& Event)
+	{
+		Origin = Origin ? Origin : Event.Cycles;
+		Out += FString::Printf(TEXT("%lld,%.3f,%s,%s,%u,%s,%s,%s,%s,%u\n"),
+		                       Event.Tick,
+		                       Micros(Event.Cycles, Origin) / 1000.0,
+		                       KindName(Event.Kind),
+		                       Event.IsCommand ? TEXT("Command") : TEXT("Task"),
+		                       Event.ObjectId,
+		                       *ObjectName(Event.ClassId),
+		                       *ObjectName(Event.ObjectId),
+		                       *MTaskNames::ValueName(Event.From),
+		                       *MTaskNames::ValueName(Event.To),
+		                       Event.RelatedId);
+	});
+	return Out;
+}
+
+void FMTaskEventLog::Reset()
+{
+	for (auto& Slot : Slots)
+	{
+		Slot.Sequence = 0;
+	}
+	Head = 0;
+}
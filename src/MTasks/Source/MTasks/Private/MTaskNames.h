@@ -0,0 +1,21 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+namespace MTaskNames
+{
+	/** An enum value without its type prefix; "Resolved" rather than "EMTaskState::Resolved" */
+	template <typename TEnum>
+	FString ValueName(TEnum Value)
+	{
+		auto Name = UEnum::GetValueAsString(Value);
+		int32 Separator;
+		if (Name.FindLastChar(TEXT(':'), Separator))
+		{
+			Name.RightChopInline(Separator + 1);
+		}
+		return Name;
+	}
+}
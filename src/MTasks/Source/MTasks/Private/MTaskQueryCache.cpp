@@ -0,0 +1,78 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "MTaskQueryCache.h"
+#include "Camera/PlayerCameraManager.h"
+#include "GameFramework/PlayerController.h"
+#include "Standard/Pickable/MStdPickTrace.h"
+
+AActor* FMTaskQueryCache::GetViewTarget(APlayerController* PlayerController)
+{
+	if (!PlayerController) return nullptr;
+	if (const auto Cached = ViewTargets.Find(PlayerController))
+	{
+		return Cached->Get();
+	}
+
+	QueriesRun += 1;
+	const auto CameraManager = PlayerController->PlayerCameraManager;
+	const auto ViewTarget = CameraManager ? CameraManager->GetViewTarget() : nullptr;
+	ViewTargets.Add(PlayerController, ViewTarget);
+	return ViewTarget;
+}
+
+void FMTaskQueryCache::GetPlayerViewPoint(APlayerController* PlayerController, FVector& OutLocation, FRotator& OutRotation)
+{
+	OutLocation = FVector::ZeroVector;
+	OutRotation = FRotator::ZeroRotator;
+	if (!PlayerController) return;
+
+	if (const auto Cached = ViewPoints.Find(PlayerController))
+	{
+		OutLocation = Cached->Location;
+		OutRotation = Cached->Rotation;
+		return;
+	}
+
+	QueriesRun += 1;
+	PlayerController->GetPlayerViewPoint(OutLocation, OutRotation);
+	ViewPoints.Add(PlayerController, FViewPoint{OutLocation, OutRotation});
+}
+
+bool FMTaskQueryCache::GetHitResultUnderCursor(APlayerController* PlayerController, ETraceTypeQuery TraceType, bool bTraceComplex, FHitResult& OutHit)
+{
+	OutHit = FHitResult();
+	if (!PlayerController) return false;
+
+	const auto Key = TPair<const APlayerController*, int32>(PlayerController, static_cast<int32>(TraceType) << 1 | bTraceComplex);
+	if (const auto Cached = CursorHits.Find(Key))
+	{
+		OutHit = Cached->Hit;
+		return Cached->DidHit;
+	}
+
+	QueriesRun += 1;
+	const auto DidHit = FMStdPickTrace::GetHitResultUnderCursor(PlayerController, TraceType, bTraceComplex, OutHit);
+	CursorHits.Add(Key, FCursorHit{DidHit, OutHit});
+	return DidHit;
+}
+
+void FMTaskQueryCache::Invalidate(const APlayerController* PlayerController)
+{
+	ViewTargets.Remove(PlayerController);
+	ViewPoints.Remove(PlayerController);
+	for (auto It = CursorHits.CreateIterator(); It; ++It)
+	{
+		if (It.Key().Key == PlayerController)
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+void FMTaskQueryCache::Reset()
+{
+	ViewTargets.Reset();
+	ViewPoints.Reset();
+	CursorHits.Reset();
+	QueriesRun = 0;
+}
@@ -1,13 +1,15 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "MTasks.h"
+#include "MTasksLog.h"
 
 #define LOCTEXT_NAMESPACE "FMTasksModule"
 
+DEFINE_LOG_CATEGORY(LogMTasks);
+
 void FMTasksModule::StartupModule()
 {
 	// This code will execute after your module is loaded into memory; the exact timing is specified in the .uplugin file per-module
-	
 }
 
 void FMTasksModule::ShutdownModule()
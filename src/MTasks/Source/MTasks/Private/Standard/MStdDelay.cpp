@@ -1,6 +1,7 @@
 // Fill out your copyright notice in the Description page of Project Settings.
 
 #include "Standard/MStdDelay.h"
+#include "MTasksLog.h"
 
 UMStdDelay* UMStdDelay::StdDelay(UObject* WorldContextObject, int Seconds, int Ticks)
 {
@@ -18,13 +19,25 @@ EMTaskState UMStdDelay::OnPoll_Implementation(float DeltaTime)
 
 	if (WaitTicks < 0 && WaitSeconds < 0)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("UMStdDelay: Invalid delay time; you must set WaitTicks or WaitSeconds"));
+		UE_LOG(LogMTasks, Warning, TEXT("UMStdDelay: Invalid delay time; you must set WaitTicks or WaitSeconds"));
 		return EMTaskState::Rejected;
 	}
 
 	ElapsedSeconds += DeltaTime;
 	ElapsedTicks += 1;
 
+	// Report whichever limit is closer to finishing
+	auto Fraction = 0.0f;
+	if (WaitTicks > 0)
+	{
+		Fraction = FMath::Max(Fraction, ElapsedTicks / static_cast<float>(WaitTicks));
+	}
+	if (WaitSeconds > 0)
+	{
+		Fraction = FMath::Max(Fraction, ElapsedSeconds / WaitSeconds);
+	}
+	SetProgress(Fraction);
+
 	if (WaitTicks != -1 && ElapsedTicks >= WaitTicks)
 	{
 		return EMTaskState::Resolved;
@@ -2,13 +2,15 @@
 
 
 #include "Standard/MStdPossess.h"
+#include "MTasksLog.h"
+#include "MTaskQueryCache.h"
 
 UMStdPossess* UMStdPossess::StdPossess(UObject* WorldContextObject, APlayerController* InPlayerController,
                                        APawn* InTargetPawn, float InOverSeconds, bool LockPlayerInput)
 {
 	if (!WorldContextObject)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("UMStdPossess: Invalid world context object"));
+		UE_LOG(LogMTasks, Warning, TEXT("UMStdPossess: Invalid world context object"));
 		return nullptr;
 	}
 
@@ -26,7 +28,7 @@ EMTaskState UMStdPossess::OnPoll_Implementation(float DeltaTime)
 {
 	if (!Validated)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("UMStdPossess: Invalid arguments"));
+		UE_LOG(LogMTasks, Warning, TEXT("UMStdPossess: Invalid arguments"));
 		return EMTaskState::Rejected;
 	}
 
@@ -37,46 +39,47 @@ EMTaskState UMStdPossess::OnPoll_Implementation(float DeltaTime)
 			// Lock player input	
 		}
 
-		auto OriginalTarget = PlayerController->PlayerCameraManager->GetViewTarget();
-		auto OriginalCamera = Cast<UCameraComponent>(
-			OriginalTarget->GetComponentByClass(UCameraComponent::StaticClass()));
+		// Possessing changes the view target, so the cached answer is dropped afterwards
+		const auto Queries = GetQueryCache();
+		auto OriginalTarget = Queries ? Queries->GetViewTarget(PlayerController) : PlayerController->PlayerCameraManager->GetViewTarget();
+		auto OriginalCamera = OriginalTarget ? Cast<UCameraComponent>(
+			OriginalTarget->GetComponentByClass(UCameraComponent::StaticClass())) : nullptr;
 		if (!OriginalCamera)
 		{
-			UE_LOG(LogTemp, Warning, TEXT("UMStdPossess: Controller did not have an original camera"))
+			UE_LOG(LogMTasks, Warning, TEXT("UMStdPossess: Controller did not have an original camera"))
 			return EMTaskState::Rejected;
 		}
 
 		PlayerController->Possess(TargetPawn);
+		if (Queries)
+		{
+			Queries->Invalidate(PlayerController);
+		}
 
 		auto NewTarget = PlayerController->PlayerCameraManager->GetViewTarget();
-		NewCamera = Cast<UCameraComponent>(NewTarget->GetComponentByClass(UCameraComponent::StaticClass()));
-		if (!NewCamera.IsValid())
+		auto NewCamera = Cast<UCameraComponent>(NewTarget->GetComponentByClass(UCameraComponent::StaticClass()));
+		if (!NewCamera)
 		{
-			UE_LOG(LogTemp, Warning, TEXT("UMStdPossess: Pawn to possess did not have a camera"))
+			UE_LOG(LogMTasks, Warning, TEXT("UMStdPossess: Pawn to possess did not have a camera"))
 			return EMTaskState::Rejected;
 		}
 
-		auto NewRelative = NewCamera->GetRelativeLocation();
-		auto OriginPoint = OriginalCamera->GetComponentLocation();
-		NewCamera->SetWorldLocation(OriginPoint);
-		auto OldRelative = NewCamera->GetRelativeLocation();
-
-		OriginalPosition = OldRelative;
-		TargetPosition = NewRelative;
+		if (!StartCameraTween(OriginalCamera, NewCamera))
+		{
+			return EMTaskState::Rejected;
+		}
 
+		// The tween starts from the old view; it is advanced from the next poll
 		InternalState = StdPossessState::Running;
-
-		UE_LOG(LogTemp, Display, TEXT("UMStdPossess: Tween camera (%s) -> (%s)"), *OldRelative.ToString(), *NewRelative.ToString());
+		return State;
 	}
 
 	if (InternalState == StdPossessState::Running)
 	{
-		Elapsed += DeltaTime;
-		if (Elapsed >= OverSeconds)
+		// The subsystem drops the tween when it finishes, or if the camera goes away
+		const auto Tweens = UMStdTweenSubsystem::Get(PlayerController);
+		if (!Tweens || !Tweens->AdvanceTween(CameraTween, DeltaTime))
 		{
-			auto Step = 1;
-			StepCamera(Step);
-
 			InternalState = StdPossessState::Completed;
 			if (LockPlayerInput)
 			{
@@ -84,9 +87,6 @@ EMTaskState UMStdPossess::OnPoll_Implementation(float DeltaTime)
 			}
 			return EMTaskState::Resolved;
 		}
-
-		auto Step = Elapsed / OverSeconds;
-		StepCamera(Step);
 	}
 
 	return State;
@@ -105,19 +105,54 @@ void UMStdPossess::OnStart_Implementation(UObject* Context)
 		return;
 	}
 
-	Elapsed = 0;
+	CameraTween = FMStdTweenHandle();
 	InternalState = StdPossessState::NotStarted;
 
 	Validated = true;
 }
 
-void UMStdPossess::StepCamera(float Amount)
+void UMStdPossess::OnEnd_Implementation()
 {
-	auto Delta = (TargetPosition - OriginalPosition) * Amount;
-	if (NewCamera.IsValid())
+	// Nothing else advances the camera tween, so finish it if the task was cancelled part way
+	const auto Tweens = UMStdTweenSubsystem::Get(PlayerController);
+	if (Tweens && Tweens->IsTweenActive(CameraTween))
 	{
-		auto NextPos = OriginalPosition + Delta;
-		// UE_LOG(LogTemp, Display, TEXT("UMStdPossess::StepCamera: %f -> %s"), Amount, *NextPos.ToString());
-		NewCamera->SetRelativeLocation(NextPos);
+		Tweens->StopTween(CameraTween, true);
 	}
+	CameraTween = FMStdTweenHandle();
+}
+
+bool UMStdPossess::StartCameraTween(UCameraComponent* OriginalCamera, UCameraComponent* NewCamera)
+{
+	const auto Tweens = UMStdTweenSubsystem::Get(PlayerController);
+	if (!Tweens)
+	{
+		UE_LOG(LogMTasks, Warning, TEXT("UMStdPossess: No tween subsystem in this world"));
+		return false;
+	}
+
+	FMStdTransformTween Tween;
+	Tween.Target = NewCamera;
+	Tween.Duration = OverSeconds;
+	Tween.Ease = Ease;
+	Tween.AdvancedByOwner = true;
+
+	// Find where the old view sits relative to the new camera's parent
+	Tween.TweenLocation = true;
+	Tween.TweenRotation = true;
+	Tween.ToLocation = NewCamera->GetRelativeLocation();
+	Tween.ToRotation = NewCamera->GetRelativeRotation();
+	NewCamera->SetWorldLocationAndRotation(OriginalCamera->GetComponentLocation(), OriginalCamera->GetComponentRotation(),
+	                                       false, nullptr, ETeleportType::TeleportPhysics);
+	Tween.FromLocation = NewCamera->GetRelativeLocation();
+	Tween.FromRotation = NewCamera->GetRelativeRotation();
+
+	Tween.TweenFieldOfView = true;
+	Tween.FromFieldOfView = OriginalCamera->FieldOfView;
+	Tween.ToFieldOfView = NewCamera->FieldOfView;
+
+	CameraTween = Tweens->StartTransformTween(Tween);
+
+	UE_LOG(LogMTasks, Display, TEXT("UMStdPossess: Tween camera (%s) -> (%s)"), *Tween.FromLocation.ToString(), *Tween.ToLocation.ToString());
+	return CameraTween.IsValid();
 }
@@ -0,0 +1,61 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Standard/Pickable/MStdPickFilter.h"
+#include "Standard/Pickable/MStdPickable.h"
+
+AActor* FMStdPickFilter::Update(AActor* HitActor, TSubclassOf<AActor> PickActorType, UObject* Picker)
+{
+	// Still over the same actor; nothing to ask
+	if (HitActor == LastHitActor.Get())
+	{
+		return Focused.Get();
+	}
+	LastHitActor = HitActor;
+
+	AActor* NewFocus = nullptr;
+	if (HitActor && IsPickableClass(HitActor->GetClass(), PickActorType))
+	{
+		if (IMStdPickable::Execute_CanBeSelected(HitActor, Picker))
+		{
+			NewFocus = HitActor;
+		}
+	}
+
+	SetFocus(NewFocus);
+	return NewFocus;
+}
+
+void FMStdPickFilter::Clear()
+{
+	LastHitActor = nullptr;
+	SetFocus(nullptr);
+}
+
+bool FMStdPickFilter::IsPickableClass(UClass* Class, TSubclassOf<AActor> PickActorType)
+{
+	if (const auto Cached = PickableClasses.Find(Class))
+	{
+		return *Cached;
+	}
+
+	const auto IsPickable = Class->IsChildOf(PickActorType) && Class->ImplementsInterface(UMStdPickable::StaticClass());
+	PickableClasses.Add(Class, IsPickable);
+	return IsPickable;
+}
+
+void FMStdPickFilter::SetFocus(AActor* Actor)
+{
+	const auto Previous = Focused.Get();
+	if (Previous == Actor) return;
+
+	Focused = Actor;
+	if (Previous)
+	{
+		IMStdPickable::Execute_OnHighlight(Previous, false);
+	}
+	if (Actor)
+	{
+		IMStdPickable::Execute_OnHighlight(Actor, true);
+	}
+}
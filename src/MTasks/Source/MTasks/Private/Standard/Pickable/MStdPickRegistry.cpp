@@ -0,0 +1,223 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Standard/Pickable/MStdPickRegistry.h"
+#include "MTasksLog.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "Standard/Pickable/MStdPickable.h"
+
+UMStdPickRegistry* UMStdPickRegistry::Get(const UObject* WorldContextObject)
+{
+	const auto World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<UMStdPickRegistry>() : nullptr;
+}
+
+void UMStdPickRegistry::RegisterPickable(AActor* Actor)
+{
+	if (!IMStdPickable::ImplementedBy(Actor))
+	{
+		UE_LOG(LogMTasks, Warning, TEXT("UMStdPickRegistry: Only IMStdPickable actors can be registered"));
+		return;
+	}
+
+	if (const auto Registry = Get(Actor))
+	{
+		Registry->Add(Actor);
+	}
+}
+
+void UMStdPickRegistry::UnregisterPickable(AActor* Actor)
+{
+	if (!Actor) return;
+	if (const auto Registry = Get(Actor))
+	{
+		Registry->Remove(Actor);
+	}
+}
+
+AActor* UMStdPickRegistry::FindNearestInCone(const FVector& Origin, const FVector& Direction, float MaxDistance, float HalfAngleDegrees,
+                                             TSubclassOf<AActor> PickActorType) const
+{
+	const auto Axis = Direction.GetSafeNormal();
+	const auto HalfAngle = FMath::DegreesToRadians(FMath::Clamp(HalfAngleDegrees, 0.0f, 180.0f));
+	const auto MinCos = FMath::Cos(HalfAngle);
+	const auto MaxDistanceSquared = MaxDistance * MaxDistance;
+
+	// Conservative bounds of the cone; the whole sphere once the cone is wider than a hemisphere
+	FBox Bounds(Origin - FVector(MaxDistance), Origin + FVector(MaxDistance));
+	if (HalfAngle < HALF_PI)
+	{
+		const auto Extent = MaxDistance * (FMath::Sin(HalfAngle) + 1.0f - MinCos);
+		const auto End = Origin + Axis * MaxDistance;
+		Bounds = FBox(End - FVector(Extent), End + FVector(Extent));
+		Bounds += Origin;
+	}
+	const auto MinCell = ToCell(Bounds.Min);
+	const auto MaxCell = ToCell(Bounds.Max);
+
+	AActor* Nearest = nullptr;
+	auto NearestDistanceSquared = MaxDistanceSquared;
+	const auto Visit = [&](const TArray<FMStdPickRegistryItem>& Items)
+	{
+		for (const auto& Item : Items)
+		{
+			const auto Offset = Item.Location - Origin;
+			const auto DistanceSquared = Offset.SizeSquared();
+			if (DistanceSquared > NearestDistanceSquared) continue;
+			if (DistanceSquared > SMALL_NUMBER && FVector::DotProduct(Offset, Axis) < MinCos * FMath::Sqrt(DistanceSquared)) continue;
+
+			const auto Actor = Item.Actor.Get();
+			if (!Actor || !Actor->GetClass()->IsChildOf(PickActorType)) continue;
+
+			Nearest = Actor;
+			NearestDistanceSquared = DistanceSquared;
+		}
+	};
+
+	// Walk whichever is smaller; the cells inside the bounds, or the occupied cells.
+	const auto BoundsCells = static_cast<int64>(MaxCell.X - MinCell.X + 1) * (MaxCell.Y - MinCell.Y + 1) * (MaxCell.Z - MinCell.Z + 1);
+	if (BoundsCells <= Cells.Num())
+	{
+		for (auto X = MinCell.X; X <= MaxCell.X; X++)
+		{
+			for (auto Y = MinCell.Y; Y <= MaxCell.Y; Y++)
+			{
+				for (auto Z = MinCell.Z; Z <= MaxCell.Z; Z++)
+				{
+					if (const auto Items = Cells.Find(FIntVector(X, Y, Z)))
+					{
+						Visit(*Items);
+					}
+				}
+			}
+		}
+	}
+	else
+	{
+		for (const auto& Cell : Cells)
+		{
+			const auto& Key = Cell.Key;
+			if (Key.X >= MinCell.X && Key.X <= MaxCell.X &&
+				Key.Y >= MinCell.Y && Key.Y <= MaxCell.Y &&
+				Key.Z >= MinCell.Z && Key.Z <= MaxCell.Z)
+			{
+				Visit(Cell.Value);
+			}
+		}
+	}
+
+	return Nearest;
+}
+
+void UMStdPickRegistry::Deinitialize()
+{
+	for (const auto& Entry : Entries)
+	{
+		if (Entry.Value.Root.IsValid())
+		{
+			Entry.Value.Root->TransformUpdated.Remove(Entry.Value.MovedHandle);
+		}
+	}
+	Entries.Reset();
+	Cells.Reset();
+	Super::Deinitialize();
+}
+
+void UMStdPickRegistry::Add(AActor* Actor)
+{
+	if (Entries.Contains(Actor)) return;
+
+	const auto Location = Actor->GetActorLocation();
+	FMStdPickRegistryEntry Entry;
+	Entry.Cell = ToCell(Location);
+	Entry.Root = Actor->GetRootComponent();
+	if (Entry.Root.IsValid())
+	{
+		Entry.MovedHandle = Entry.Root->TransformUpdated.AddUObject(this, &UMStdPickRegistry::OnPickableMoved);
+	}
+	Actor->OnDestroyed.AddUniqueDynamic(this, &UMStdPickRegistry::OnPickableDestroyed);
+
+	Cells.FindOrAdd(Entry.Cell).Add(FMStdPickRegistryItem{Actor, Location});
+	Entries.Add(Actor, Entry);
+}
+
+void UMStdPickRegistry::Remove(AActor* Actor)
+{
+	FMStdPickRegistryEntry Entry;
+	if (!Entries.RemoveAndCopyValue(Actor, Entry)) return;
+
+	if (Entry.Root.IsValid())
+	{
+		Entry.Root->TransformUpdated.Remove(Entry.MovedHandle);
+	}
+	Actor->OnDestroyed.RemoveDynamic(this, &UMStdPickRegistry::OnPickableDestroyed);
+
+	if (const auto Items = Cells.Find(Entry.Cell))
+	{
+		Items->RemoveAllSwap([&](const FMStdPickRegistryItem& Item)
+		{
+			return Item.Actor == Actor || !Item.Actor.IsValid();
+		});
+		if (Items->Num() == 0)
+		{
+			Cells.Remove(Entry.Cell);
+		}
+	}
+}
+
+void UMStdPickRegistry::Move(AActor* Actor, const FVector& Location)
+{
+	const auto Entry = Entries.Find(Actor);
+	if (!Entry) return;
+
+	const auto Cell = ToCell(Location);
+	const auto Items = Cells.Find(Entry->Cell);
+	if (!Items) return;
+
+	// Same cell, so only the location changes
+	if (Cell == Entry->Cell)
+	{
+		for (auto& Item : *Items)
+		{
+			if (Item.Actor == Actor)
+			{
+				Item.Location = Location;
+				return;
+			}
+		}
+		return;
+	}
+
+	Items->RemoveAllSwap([&](const FMStdPickRegistryItem& Item)
+	{
+		return Item.Actor == Actor;
+	});
+	if (Items->Num() == 0)
+	{
+		Cells.Remove(Entry->Cell);
+	}
+
+	Entry->Cell = Cell;
+	Cells.FindOrAdd(Cell).Add(FMStdPickRegistryItem{Actor, Location});
+}
+
+void UMStdPickRegistry::OnPickableMoved(USceneComponent* Component, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport)
+{
+	if (const auto Actor = Component->GetOwner())
+	{
+		Move(Actor, Component->GetComponentLocation());
+	}
+}
+
+void UMStdPickRegistry::OnPickableDestroyed(AActor* Actor)
+{
+	Remove(Actor);
+}
+
+FIntVector UMStdPickRegistry::ToCell(const FVector& Location)
+{
+	return FIntVector(FMath::FloorToInt(Location.X / CellSize),
+	                  FMath::FloorToInt(Location.Y / CellSize),
+	                  FMath::FloorToInt(Location.Z / CellSize));
+}
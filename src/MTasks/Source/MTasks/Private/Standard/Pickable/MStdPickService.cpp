@@ -0,0 +1,281 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Standard/Pickable/MStdPickService.h"
+#include "Components/InputComponent.h"
+#include "Engine/LocalPlayer.h"
+#include "GameFramework/PlayerController.h"
+#include "MTask.h"
+#include "MTaskQueryCache.h"
+#include "Standard/Pickable/MStdPickRegistry.h"
+#include "Standard/Pickable/MStdPickTrace.h"
+
+UMStdPickService* UMStdPickService::Get(const APlayerController* InPlayerController)
+{
+	const auto LocalPlayer = InPlayerController ? InPlayerController->GetLocalPlayer() : nullptr;
+	return LocalPlayer ? LocalPlayer->GetSubsystem<UMStdPickService>() : nullptr;
+}
+
+void UMStdPickService::AddPicker(UObject* Picker, FMStdPickServiceClient* Client, APlayerController* InPlayerController,
+                                 const FMStdPickRequest& Request)
+{
+	RemovePicker(Picker);
+
+	PlayerController = InPlayerController;
+	RefreshInputComponent();
+
+	FMStdPickServiceClientEntry Entry;
+	Entry.Object = Picker;
+	Entry.Client = Client;
+	Entry.SelectAction = Request.SelectAction;
+	Entry.CancelAction = Request.CancelAction;
+	Clients.Add(Entry);
+	RetainAction(Request.SelectAction);
+	RetainAction(Request.CancelAction);
+
+	FMStdPickServiceMember Member;
+	Member.Picker = Picker;
+	for (auto& Group : Groups)
+	{
+		if (Group.Query.IsSameQuery(Request))
+		{
+			Group.Members.Add(Member);
+			return;
+		}
+	}
+
+	auto& Group = Groups.AddDefaulted_GetRef();
+	Group.Query = Request;
+	Group.Members.Add(Member);
+}
+
+void UMStdPickService::RemovePicker(UObject* Picker)
+{
+	for (auto i = Clients.Num() - 1; i >= 0; i--)
+	{
+		if (Clients[i].Object == Picker)
+		{
+			ReleaseAction(Clients[i].SelectAction);
+			ReleaseAction(Clients[i].CancelAction);
+			Clients.RemoveAt(i);
+		}
+	}
+
+	for (auto i = Groups.Num() - 1; i >= 0; i--)
+	{
+		auto& Group = Groups[i];
+		for (auto j = Group.Members.Num() - 1; j >= 0; j--)
+		{
+			auto& Member = Group.Members[j];
+			if (Member.Picker == Picker || !Member.Picker.IsValid())
+			{
+				Member.Filter.Clear();
+				Group.Members.RemoveAtSwap(j);
+			}
+		}
+		if (Group.Members.Num() == 0)
+		{
+			Groups.RemoveAtSwap(i);
+		}
+	}
+}
+
+FMStdPickResult UMStdPickService::Resolve(UObject* Picker)
+{
+	for (auto& Group : Groups)
+	{
+		const auto Member = Group.Members.FindByPredicate([&](const FMStdPickServiceMember& Other)
+		{
+			return Other.Picker == Picker;
+		});
+		if (!Member) continue;
+
+		// Only the first picker polled each frame traces; if it runs on an executor, that tick's other tasks share the answer
+		if (Group.LastFrame != GFrameCounter)
+		{
+			Group.LastFrame = GFrameCounter;
+			const auto Task = Cast<UMTask>(Picker);
+			ResolveGroup(Group, Task ? Task->GetQueryCache() : nullptr);
+		}
+
+		// The filter only asks CanBeSelected when the hit actor changes, so this is cheap for the others
+		auto Result = Group.Result;
+		Result.Focus = Member->Filter.Update(Group.Hit.Get(), Group.Query.PickActorType, Picker);
+		return Result;
+	}
+	return FMStdPickResult();
+}
+
+FMStdPickTraceState& UMStdPickService::GetTraceState(ETraceTypeQuery TraceType, bool bTraceComplex)
+{
+	return Traces.FindOrAdd(static_cast<uint32>(TraceType) << 1 | (bTraceComplex ? 1 : 0));
+}
+
+void UMStdPickService::Deinitialize()
+{
+	for (auto& Action : Actions)
+	{
+		UnbindAction(Action.Value);
+	}
+	for (auto& Group : Groups)
+	{
+		for (auto& Member : Group.Members)
+		{
+			Member.Filter.Clear();
+		}
+	}
+	Actions.Reset();
+	Groups.Reset();
+	Clients.Reset();
+	Traces.Reset();
+	Super::Deinitialize();
+}
+
+void UMStdPickService::ResolveGroup(FMStdPickServiceGroup& Group, FMTaskQueryCache* Queries)
+{
+	const auto Controller = PlayerController.Get();
+	if (!Controller)
+	{
+		Group.Result = FMStdPickResult();
+		Group.Hit = nullptr;
+		return;
+	}
+
+	auto& Result = Group.Result;
+	const auto& Query = Group.Query;
+	AActor* Hit = nullptr;
+	if (Query.Mode == EMStdPickerMode::Gamepad)
+	{
+		FVector ViewLocation;
+		FRotator ViewRotation;
+		if (Queries)
+		{
+			Queries->GetPlayerViewPoint(Controller, ViewLocation, ViewRotation);
+		}
+		else
+		{
+			Controller->GetPlayerViewPoint(ViewLocation, ViewRotation);
+		}
+		const auto ViewDirection = ViewRotation.Vector();
+
+		const auto Registry = UMStdPickRegistry::Get(Controller);
+		Hit = Registry ? Registry->FindNearestInCone(ViewLocation, ViewDirection, Query.MaxDistance, Query.HalfAngleDegrees, Query.PickActorType) : nullptr;
+
+		Result.DidHit = Hit != nullptr;
+		Result.Location = Hit ? Hit->GetActorLocation() : ViewLocation + ViewDirection * Query.MaxDistance;
+		Result.Normal = -ViewDirection;
+	}
+	else
+	{
+		// The trace is a frame old, so the hit actor may have been destroyed since
+		FHitResult HitResult;
+		Result.DidHit = Queries ? Queries->GetHitResultUnderCursor(Controller, Query.TraceType, true, HitResult) : FMStdPickTrace::GetHitResultUnderCursor(Controller, Query.TraceType, true, HitResult);
+		Result.Location = HitResult.Location;
+		Result.Normal = HitResult.Normal;
+		Hit = Result.DidHit ? HitResult.GetActor() : nullptr;
+	}
+
+	Group.Hit = Hit;
+}
+
+void UMStdPickService::RetainAction(FName Action)
+{
+	if (Action.IsNone()) return;
+	auto& Binding = Actions.FindOrAdd(Action);
+	Binding.RefCount += 1;
+	if (Binding.RefCount == 1)
+	{
+		BindAction(Action, Binding);
+	}
+}
+
+void UMStdPickService::ReleaseAction(FName Action)
+{
+	const auto Binding = Actions.Find(Action);
+	if (!Binding) return;
+	Binding->RefCount -= 1;
+	if (Binding->RefCount <= 0)
+	{
+		UnbindAction(*Binding);
+		Actions.Remove(Action);
+	}
+}
+
+void UMStdPickService::BindAction(FName Action, FMStdPickServiceAction& Binding)
+{
+	const auto Input = BoundInputComponent.Get();
+	if (!Input) return;
+
+	FInputActionBinding Pressed(Action, IE_Pressed);
+	Pressed.ActionDelegate.GetDelegateForManualSet().BindUObject(this, &UMStdPickService::OnActionPressed, Action);
+	Binding.PressedHandle = Input->AddActionBinding(Pressed).GetHandle();
+
+	FInputActionBinding Released(Action, IE_Released);
+	Released.ActionDelegate.GetDelegateForManualSet().BindUObject(this, &UMStdPickService::OnActionReleased, Action);
+	Binding.ReleasedHandle = Input->AddActionBinding(Released).GetHandle();
+}
+
+void UMStdPickService::UnbindAction(FMStdPickServiceAction& Binding)
+{
+	if (const auto Input = BoundInputComponent.Get())
+	{
+		Input->RemoveActionBindingForHandle(Binding.PressedHandle);
+		Input->RemoveActionBindingForHandle(Binding.ReleasedHandle);
+	}
+	Binding.PressedHandle = INDEX_NONE;
+	Binding.ReleasedHandle = INDEX_NONE;
+}
+
+void UMStdPickService::RefreshInputComponent()
+{
+	UInputComponent* Input = PlayerController.IsValid() ? PlayerController->InputComponent : nullptr;
+	if (Input == BoundInputComponent.Get()) return;
+
+	for (auto& Action : Actions)
+	{
+		UnbindAction(Action.Value);
+	}
+	BoundInputComponent = Input;
+	for (auto& Action : Actions)
+	{
+		BindAction(Action.Key, Action.Value);
+	}
+}
+
+void UMStdPickService::OnActionPressed(FName Action)
+{
+	// Handlers may add or remove pickers, so dispatch from a copy
+	const auto Targets = Clients;
+	for (const auto& Target : Targets)
+	{
+		if (!IsStillRegistered(Target)) continue;
+		if (Target.SelectAction == Action)
+		{
+			Target.Client->OnPickSelectPressed();
+		}
+		if (Target.CancelAction == Action)
+		{
+			Target.Client->OnPickCancelPressed();
+		}
+	}
+}
+
+void UMStdPickService::OnActionReleased(FName Action)
+{
+	const auto Targets = Clients;
+	for (const auto& Target : Targets)
+	{
+		if (IsStillRegistered(Target) && Target.SelectAction == Action)
+		{
+			Target.Client->OnPickSelectReleased();
+		}
+	}
+}
+
+bool UMStdPickService::IsStillRegistered(const FMStdPickServiceClientEntry& Target) const
+{
+	return Target.Object.IsValid() && Clients.ContainsByPredicate([&](const FMStdPickServiceClientEntry& Other)
+	{
+		return Other.Object == Target.Object;
+	});
+}
@@ -0,0 +1,82 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Standard/Pickable/MStdPickTrace.h"
+#include "Engine/LocalPlayer.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "Standard/Pickable/MStdPickService.h"
+
+namespace FMStdPickTraceInternals
+{
+	/** Consume the result of the trace issued last frame, if it is still available */
+	void ConsumeTrace(UWorld* World, FMStdPickTraceState& State)
+	{
+		FTraceDatum Datum;
+		if (State.Handle.IsValid() && World->QueryTraceData(State.Handle, Datum))
+		{
+			State.HasHit = Datum.OutHits.Num() > 0 && Datum.OutHits[0].bBlockingHit;
+			State.Hit = State.HasHit ? Datum.OutHits[0] : FHitResult();
+		}
+		State.Handle = FTraceHandle();
+	}
+
+	/** Deproject the cursor and issue an async trace along it */
+	void IssueTrace(UWorld* World, APlayerController* PlayerController, ETraceTypeQuery TraceType, bool bTraceComplex, FMStdPickTraceState& State)
+	{
+		const auto LocalPlayer = Cast<ULocalPlayer>(PlayerController->Player);
+		if (!LocalPlayer || !LocalPlayer->ViewportClient)
+		{
+			State.HasHit = false;
+			return;
+		}
+
+		FVector2D MousePosition;
+		FVector WorldOrigin;
+		FVector WorldDirection;
+		if (!LocalPlayer->ViewportClient->GetMousePosition(MousePosition) ||
+			!PlayerController->DeprojectScreenPositionToWorld(MousePosition.X, MousePosition.Y, WorldOrigin, WorldDirection))
+		{
+			State.HasHit = false;
+			return;
+		}
+
+		const FCollisionQueryParams Params(SCENE_QUERY_STAT(MStdPickTrace), bTraceComplex);
+		State.Handle = World->AsyncLineTraceByChannel(EAsyncTraceType::Single,
+		                                              WorldOrigin,
+		                                              WorldOrigin + WorldDirection * PlayerController->HitResultTraceDistance,
+		                                              UEngineTypes::ConvertToCollisionChannel(TraceType),
+		                                              Params);
+	}
+}
+
+bool FMStdPickTrace::GetHitResultUnderCursor(APlayerController* PlayerController, ETraceTypeQuery TraceType, bool bTraceComplex, FHitResult& OutResult)
+{
+	using namespace FMStdPickTraceInternals;
+
+	if (!PlayerController) return false;
+	const auto World = PlayerController->GetWorld();
+	if (!World) return false;
+	const auto Service = UMStdPickService::Get(PlayerController);
+	if (!Service) return false;
+
+	// A handle issued for another controller or world means nothing here
+	auto& State = Service->GetTraceState(TraceType, bTraceComplex);
+	if (State.PlayerController != PlayerController || State.World != World)
+	{
+		State = FMStdPickTraceState();
+		State.PlayerController = PlayerController;
+		State.World = World;
+	}
+
+	// Only the first request each frame does any work
+	if (State.LastFrame != GFrameCounter)
+	{
+		State.LastFrame = GFrameCounter;
+		ConsumeTrace(World, State);
+		IssueTrace(World, PlayerController, TraceType, bTraceComplex, State);
+	}
+
+	OutResult = State.Hit;
+	return State.HasHit;
+}
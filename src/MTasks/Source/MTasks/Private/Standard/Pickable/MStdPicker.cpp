@@ -2,8 +2,10 @@
 
 
 #include "Standard/Pickable/MStdPicker.h"
+#include "MTasksLog.h"
 #include "Actors/MStdExecutor.h"
 #include "Standard/Pickable/MStdPickable.h"
+#include "Standard/Pickable/MStdPickService.h"
 
 UMStdPicker* UMStdPicker::StdPicker(UObject* WorldContextObject, APlayerController* InPlayerController,
                                     ETraceTypeQuery InTraceType,
@@ -12,13 +14,13 @@ UMStdPicker* UMStdPicker::StdPicker(UObject* WorldContextObject, APlayerControll
 {
 	if (!InPlayerController)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("Invalid PlayerController: null"));
+		UE_LOG(LogMTasks, Warning, TEXT("Invalid PlayerController: null"));
 		return nullptr;
 	}
 
 	if (!WorldContextObject)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("Invalid WorldContextObject: null"));
+		UE_LOG(LogMTasks, Warning, TEXT("Invalid WorldContextObject: null"));
 		return nullptr;
 	}
 
@@ -28,21 +30,52 @@ UMStdPicker* UMStdPicker::StdPicker(UObject* WorldContextObject, APlayerControll
 	Instance->PickerState = EMStdPickerState::Seeking;
 	Instance->PlayerController = InPlayerController;
 	Instance->TraceType = InTraceType;
-
-	Instance->OnSelectBinding = FInputActionBinding(SelectAction, IE_Pressed);
-	Instance->OnSelectBinding.ActionDelegate.BindDelegate(Instance, &UMStdPicker::OnSelectPressed);
-	Instance->OnSelectBinding = Instance->PlayerController->InputComponent->AddActionBinding(Instance->OnSelectBinding);
-
-	Instance->OnCancelBinding = FInputActionBinding(CancelAction, IE_Pressed);
-	Instance->OnCancelBinding.ActionDelegate.BindDelegate(Instance, &UMStdPicker::OnCancelPressed);
-	Instance->OnCancelBinding = Instance->PlayerController->InputComponent->AddActionBinding(Instance->OnCancelBinding);
-
+	Instance->SelectAction = SelectAction;
+	Instance->CancelAction = CancelAction;
 	Instance->PickedActor = nullptr;
 	Instance->PickActorType = InPickActorOfType;
 
 	return Instance;
 }
 
+UMStdPicker* UMStdPicker::StdPickerGamepad(UObject* WorldContextObject, APlayerController* InPlayerController,
+                                           FName SelectAction, FName CancelAction, float InTimeout,
+                                           TSubclassOf<AActor> InPickActorOfType, float InMaxDistance, float InHalfAngleDegrees)
+{
+	const auto Instance = StdPicker(WorldContextObject, InPlayerController, TraceTypeQuery1, SelectAction, CancelAction, InTimeout,
+	                                InPickActorOfType);
+	if (!Instance)
+	{
+		return nullptr;
+	}
+
+	Instance->Mode = EMStdPickerMode::Gamepad;
+	Instance->GamepadMaxDistance = InMaxDistance;
+	Instance->GamepadHalfAngle = InHalfAngleDegrees;
+	return Instance;
+}
+
+void UMStdPicker::OnStart_Implementation(UObject* Context)
+{
+	const auto Service = UMStdPickService::Get(PlayerController);
+	if (!Service)
+	{
+		UE_LOG(LogMTasks, Warning, TEXT("UMStdPicker: PlayerController has no local player to pick with"));
+		PickerState = EMStdPickerState::PickCancelled;
+		return;
+	}
+
+	FMStdPickRequest Request;
+	Request.Mode = Mode;
+	Request.TraceType = TraceType;
+	Request.PickActorType = PickActorType;
+	Request.MaxDistance = GamepadMaxDistance;
+	Request.HalfAngleDegrees = GamepadHalfAngle;
+	Request.SelectAction = SelectAction;
+	Request.CancelAction = CancelAction;
+	Service->AddPicker(this, this, PlayerController, Request);
+}
+
 EMTaskState UMStdPicker::OnPoll_Implementation(float DeltaTime)
 {
 	if (State != EMTaskState::Running) return State;
@@ -70,12 +103,17 @@ EMTaskState UMStdPicker::OnPoll_Implementation(float DeltaTime)
 		return State; // Resolve next tick
 	}
 
-	// If we're still looking, raycast for actors
+	// If we're still looking, ask the pick service what we're over
 	ScanForWorldActor();
 	return State;
 }
 
-void UMStdPicker::OnSelectPressed()
+void UMStdPicker::OnEnd_Implementation()
+{
+	UnregisterPicker();
+}
+
+void UMStdPicker::OnPickSelectPressed()
 {
 	if (PickedActor)
 	{
@@ -83,56 +121,49 @@ void UMStdPicker::OnSelectPressed()
 	}
 }
 
-void UMStdPicker::OnCancelPressed()
+void UMStdPicker::OnPickSelectReleased()
+{
+}
+
+void UMStdPicker::OnPickCancelPressed()
 {
 	AbortPick();
 }
 
 void UMStdPicker::ScanForWorldActor()
 {
-	FHitResult Result;
-	auto DidMatch = false;
-	if (PlayerController->GetHitResultUnderCursorByChannel(TraceType, true, Result))
+	const auto Service = UMStdPickService::Get(PlayerController);
+	if (!Service)
 	{
-		const auto Other = Result.GetActor();
-		const auto IsCorrectType = Other->GetClass()->IsChildOf(PickActorType);
-		if (IsCorrectType && IMStdPickable::ImplementedBy(Other))
-		{
-			const bool CanAcceptPick = IMStdPickable::Execute_CanBeSelected(Other, this);
-			if (CanAcceptPick)
-			{
-				PickedActor = Other;
-				IMStdPickable::Execute_OnHighlight(PickedActor, true);
-				DidMatch = true;
-			}
-		}
-		OnTick.Broadcast(true, DidMatch, Result.Location, Result.Normal);
-	}
-	else
-	{
-		OnTick.Broadcast(false, false, Result.Location, Result.Normal);
+		AbortPick();
+		return;
 	}
-	if (!DidMatch)
+
+	const auto Result = Service->Resolve(this);
+	PickedActor = Result.Focus.Get();
+
+	if (OnTick.IsBound())
 	{
-		PickedActor = nullptr;
+		OnTick.Broadcast(Result.DidHit, PickedActor != nullptr, Result.Location, Result.Normal);
 	}
 }
 
-void UMStdPicker::ClearBindings() const
+void UMStdPicker::UnregisterPicker()
 {
-	if (!PlayerController) return;
-	PlayerController->InputComponent->RemoveActionBindingForHandle(OnSelectBinding.GetHandle());
-	PlayerController->InputComponent->RemoveActionBindingForHandle(OnCancelBinding.GetHandle());
+	if (const auto Service = UMStdPickService::Get(PlayerController))
+	{
+		Service->RemovePicker(this);
+	}
 }
 
 void UMStdPicker::PickCurrent()
 {
 	PickerState = EMStdPickerState::Picked;
-	ClearBindings();
+	UnregisterPicker();
 }
 
 void UMStdPicker::AbortPick()
 {
 	PickerState = EMStdPickerState::PickCancelled;
-	ClearBindings();
+	UnregisterPicker();
 }
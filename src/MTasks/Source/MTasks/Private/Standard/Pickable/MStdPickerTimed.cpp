@@ -2,35 +2,25 @@
 
 
 #include "Standard/Pickable/MStdPickerTimed.h"
+#include "MTasksLog.h"
 
 #include "Standard/Pickable/MStdPickable.h"
+#include "Standard/Pickable/MStdPickService.h"
 #include "Standard/Pickable/MStdPicker.h"
 
-UENUM(BlueprintType, Category="MTasks|Standard|Pickable")
-enum class EMStdPickerTimedState : uint8
-{
-	Idle,
-	PickSeek,
-	// Seeking a target to pick
-	PickStarted,
-	// Collecting time towards the given pick
-	Picked,
-	PickCancelled
-};
-
 UMStdPickerTimed* UMStdPickerTimed::StdPickerTimed(UObject* WorldContextObject, APlayerController* InPlayerController, ETraceTypeQuery InTraceType,
                                                    FName SelectAction, FName CancelAction, float InTimeout, float InPickAfterTime,
                                                    TSubclassOf<AActor> InPickActorOfType)
 {
 	if (!InPlayerController)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("Invalid PlayerController: null"));
+		UE_LOG(LogMTasks, Warning, TEXT("Invalid PlayerController: null"));
 		return nullptr;
 	}
 
 	if (!WorldContextObject)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("Invalid WorldContextObject: null"));
+		UE_LOG(LogMTasks, Warning, TEXT("Invalid WorldContextObject: null"));
 		return nullptr;
 	}
 
@@ -43,141 +33,185 @@ UMStdPickerTimed* UMStdPickerTimed::StdPickerTimed(UObject* WorldContextObject,
 	Instance->PickedTimeSoFar = 0;
 	Instance->PickAfterTime = InPickAfterTime;
 
-	Instance->OnSelectPressedBinding = FInputActionBinding(SelectAction, IE_Pressed);
-	Instance->OnSelectPressedBinding.ActionDelegate.BindDelegate(Instance, &UMStdPickerTimed::OnSelectPressed);
-	Instance->OnSelectPressedBinding = Instance->PlayerController->InputComponent->AddActionBinding(Instance->OnSelectPressedBinding);
-
-	Instance->OnSelectReleasedBinding = FInputActionBinding(SelectAction, IE_Released);
-	Instance->OnSelectReleasedBinding.ActionDelegate.BindDelegate(Instance, &UMStdPickerTimed::OnSelectReleased);
-	Instance->OnSelectReleasedBinding = Instance->PlayerController->InputComponent->AddActionBinding(Instance->OnSelectPressedBinding);
-	
-	Instance->OnCancelBinding = FInputActionBinding(CancelAction, IE_Pressed);
-	Instance->OnCancelBinding.ActionDelegate.BindDelegate(Instance, &UMStdPickerTimed::OnCancelPressed);
-	Instance->OnCancelBinding = Instance->PlayerController->InputComponent->AddActionBinding(Instance->OnCancelBinding);
-
+	Instance->SelectAction = SelectAction;
+	Instance->CancelAction = CancelAction;
 	Instance->PickedActor = nullptr;
 	Instance->PickActorType = InPickActorOfType;
 
 	return Instance;
 }
 
+void UMStdPickerTimed::OnStart_Implementation(UObject* Context)
+{
+	const auto Service = UMStdPickService::Get(PlayerController);
+	if (!Service)
+	{
+		UE_LOG(LogMTasks, Warning, TEXT("UMStdPickerTimed: PlayerController has no local player to pick with"));
+		PickerState = EMStdPickerState::PickCancelled;
+		return;
+	}
+
+	FMStdPickRequest Request;
+	Request.TraceType = TraceType;
+	Request.PickActorType = PickActorType;
+	Request.SelectAction = SelectAction;
+	Request.CancelAction = CancelAction;
+	Service->AddPicker(this, this, PlayerController, Request);
+}
+
 EMTaskState UMStdPickerTimed::OnPoll_Implementation(float DeltaTime)
 {
 	if (State != EMTaskState::Running) return State;
 
-	// If the pick was cancelled, abort
-	if (PickerState == EMStdPickerState::PickCancelled)
+	switch (PickerState)
 	{
+	case EMStdPickerState::PickCancelled:
 		PickedActor = nullptr;
 		PlayerController = nullptr;
 		return EMTaskState::Rejected;
-	}
 
-	// If the pick was completed, resolve
-	if (PickerState == EMStdPickerState::Picked)
-	{
+	case EMStdPickerState::Picked:
 		PlayerController = nullptr;
-		IMStdPickable::Execute_OnPicked(PickedActor, 0);
+		IMStdPickable::Execute_OnPicked(PickedActor, PickedTimeSoFar);
 		return EMTaskState::Resolved;
-	}
 
-	// If the pick is in progress, update the total
-	if (PickerState == EMStdPickerState::PickStarted)
-	{
-		PickedTimeSoFar += DeltaTime;
-		if (PickedTimeSoFar > PickAfterTime)
-		{
-			PickedTimeSoFar = PickAfterTime;
-		}
-		
-		IMStdPickable::Execute_OnPicking(PickedActor, PickedTimeSoFar, PickAfterTime);
+	case EMStdPickerState::PickStarted:
+		return PollPickStarted(DeltaTime);
 
-		// If we actually finished, wait until next frame to resolve
-		if (PickedTimeSoFar >= PickAfterTime)
-		{
-			PickerState = EMStdPickerState::Picked;
-			ClearBindings();
-			return State;
-		}
+	default:
+		return PollSeeking(DeltaTime);
 	}
+}
 
+EMTaskState UMStdPickerTimed::PollSeeking(float DeltaTime)
+{
 	Elapsed += DeltaTime;
 	if (Elapsed > Timeout)
 	{
 		AbortPick();
-		return State; // Resolve next tick
+		return State; // Reject next tick
 	}
 
-	// If we're still looking, raycast for actors
+	// Ask the pick service what we're over
 	ScanForWorldActor();
 	return State;
 }
 
-void UMStdPickerTimed::OnSelectReleased()
+EMTaskState UMStdPickerTimed::PollPickStarted(float DeltaTime)
+{
+	Elapsed += DeltaTime;
+	if (Elapsed > Timeout)
+	{
+		AbortPick();
+		return State; // Reject next tick
+	}
+
+	if (!IsValid(PickedActor))
+	{
+		ResetPick();
+		return State;
+	}
+
+	SinceRevalidate += DeltaTime;
+	if (RevalidateInterval <= 0 || SinceRevalidate >= RevalidateInterval)
+	{
+		SinceRevalidate = 0;
+		if (!RevalidateTarget())
+		{
+			ResetPick();
+			return State;
+		}
+	}
+
+	PickedTimeSoFar = FMath::Min(PickedTimeSoFar + DeltaTime, PickAfterTime);
+	IMStdPickable::Execute_OnPicking(PickedActor, PickedTimeSoFar, PickAfterTime);
+	SetProgress(PickAfterTime > 0 ? PickedTimeSoFar / PickAfterTime : 1);
+
+	// If we actually finished, wait until next frame to resolve
+	if (PickedTimeSoFar >= PickAfterTime)
+	{
+		PickerState = EMStdPickerState::Picked;
+		UnregisterPicker();
+	}
+	return State;
+}
+
+bool UMStdPickerTimed::RevalidateTarget()
+{
+	const auto Service = UMStdPickService::Get(PlayerController);
+	if (!Service) return false;
+	return Service->Resolve(this).Focus.Get() == PickedActor;
+}
+
+void UMStdPickerTimed::ResetPick()
 {
 	PickerState = EMStdPickerState::Seeking;
 	PickedTimeSoFar = 0;
+	SinceRevalidate = 0;
+	SetProgress(0);
 }
 
+void UMStdPickerTimed::OnEnd_Implementation()
+{
+	UnregisterPicker();
+}
+
+void UMStdPickerTimed::OnPickSelectReleased()
+{
+	if (PickerState != EMStdPickerState::PickStarted) return;
+	ResetPick();
+}
 
-void UMStdPickerTimed::OnSelectPressed()
+void UMStdPickerTimed::OnPickSelectPressed()
 {
-	if (PickedActor)
+	if (PickerState != EMStdPickerState::Seeking) return;
+	if (IsValid(PickedActor))
 	{
 		PickCurrent();
 	}
 }
 
-void UMStdPickerTimed::OnCancelPressed()
+void UMStdPickerTimed::OnPickCancelPressed()
 {
 	AbortPick();
 }
 
 void UMStdPickerTimed::ScanForWorldActor()
 {
-	FHitResult Result;
-	auto DidMatch = false;
-	if (PlayerController->GetHitResultUnderCursorByChannel(TraceType, true, Result))
-	{
-		const auto Other = Result.GetActor();
-		const auto IsCorrectType = Other->GetClass()->IsChildOf(PickActorType);
-		if (IsCorrectType && IMStdPickable::ImplementedBy(Other))
-		{
-			const bool CanAcceptPick = IMStdPickable::Execute_CanBeSelected(Other, this);
-			if (CanAcceptPick)
-			{
-				PickedActor = Other;
-				IMStdPickable::Execute_OnHighlight(PickedActor, true);
-				DidMatch = true;
-			}
-		}
-		OnTick.Broadcast(true, DidMatch, Result.Location, Result.Normal);
-	}
-	else
+	const auto Service = UMStdPickService::Get(PlayerController);
+	if (!Service)
 	{
-		OnTick.Broadcast(false, false, Result.Location, Result.Normal);
+		AbortPick();
+		return;
 	}
-	if (!DidMatch)
+
+	const auto Result = Service->Resolve(this);
+	PickedActor = Result.Focus.Get();
+
+	if (OnTick.IsBound())
 	{
-		PickedActor = nullptr;
+		OnTick.Broadcast(Result.DidHit, PickedActor != nullptr, Result.Location, Result.Normal);
 	}
 }
 
-void UMStdPickerTimed::ClearBindings() const
+void UMStdPickerTimed::UnregisterPicker()
 {
-	if (!PlayerController) return;
-	PlayerController->InputComponent->RemoveActionBindingForHandle(OnSelectPressedBinding.GetHandle());
-	PlayerController->InputComponent->RemoveActionBindingForHandle(OnSelectReleasedBinding.GetHandle());
-	PlayerController->InputComponent->RemoveActionBindingForHandle(OnCancelBinding.GetHandle());
+	if (const auto Service = UMStdPickService::Get(PlayerController))
+	{
+		Service->RemovePicker(this);
+	}
 }
 
 void UMStdPickerTimed::PickCurrent()
 {
 	PickerState = EMStdPickerState::PickStarted;
+	PickedTimeSoFar = 0;
+	SinceRevalidate = 0;
 }
 
 void UMStdPickerTimed::AbortPick()
 {
+	if (PickerState == EMStdPickerState::Picked) return;
 	PickerState = EMStdPickerState::PickCancelled;
-	ClearBindings();
+	UnregisterPicker();
 }
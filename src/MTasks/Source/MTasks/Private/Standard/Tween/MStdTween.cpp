@@ -0,0 +1,150 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Standard/Tween/MStdTween.h"
+#include "MTasksLog.h"
+
+namespace MStdTweenInternals
+{
+	template <typename T>
+	T* NewTween(UObject* WorldContextObject)
+	{
+		if (!WorldContextObject)
+		{
+			UE_LOG(LogMTasks, Warning, TEXT("UMStdTween: Invalid world context object"));
+			return nullptr;
+		}
+		return NewObject<T>(WorldContextObject);
+	}
+}
+
+void UMStdTween::InitTween(UObject* InTarget, FName InPropertyName, float InOverSeconds, EMStdEase InEase, UCurveFloat* InCurve)
+{
+	Target = InTarget;
+	PropertyName = InPropertyName;
+	OverSeconds = InOverSeconds < 0 ? 0 : InOverSeconds;
+	Ease = InEase;
+	Curve = InCurve;
+}
+
+void UMStdTween::OnStart_Implementation(UObject* Context)
+{
+	Handle = FMStdTweenHandle();
+
+	const auto Tweens = UMStdTweenSubsystem::Get(Target);
+	if (!Tweens)
+	{
+		UE_LOG(LogMTasks, Warning, TEXT("UMStdTween: Target is not in a world with a tween subsystem"));
+		return;
+	}
+
+	FMStdTweenTiming Timing;
+	Timing.Duration = OverSeconds;
+	Timing.Ease = Ease;
+	Timing.Curve = Curve;
+	Handle = StartTween(Tweens, FMStdTweenBinding::ForProperty(Target, PropertyName), Timing);
+}
+
+EMTaskState UMStdTween::OnPoll_Implementation(float DeltaTime)
+{
+	if (State != EMTaskState::Running) return State;
+	if (!Handle.IsValid()) return EMTaskState::Rejected;
+
+	const auto Tweens = UMStdTweenSubsystem::Get(Target);
+	if (Tweens && Tweens->IsTweenActive(Handle)) return State;
+
+	// The subsystem drops finished tweens and tweens that lost their target
+	Handle = FMStdTweenHandle();
+	return IsValid(Target) ? EMTaskState::Resolved : EMTaskState::Rejected;
+}
+
+void UMStdTween::OnEnd_Implementation()
+{
+	// Cancelled before the tween finished; leave the value where it is
+	if (!Handle.IsValid()) return;
+	if (const auto Tweens = UMStdTweenSubsystem::Get(Target))
+	{
+		Tweens->StopTween(Handle, false);
+	}
+	Handle = FMStdTweenHandle();
+}
+
+UMStdTweenFloat* UMStdTweenFloat::StdTweenFloat(UObject* WorldContextObject, UObject* InTarget, FName InPropertyName, float InFrom, float InTo,
+                                                float InOverSeconds, EMStdEase InEase, UCurveFloat* InCurve)
+{
+	const auto Instance = MStdTweenInternals::NewTween<UMStdTweenFloat>(WorldContextObject);
+	if (!Instance) return nullptr;
+	Instance->InitTween(InTarget, InPropertyName, InOverSeconds, InEase, InCurve);
+	Instance->From = InFrom;
+	Instance->To = InTo;
+	return Instance;
+}
+
+FMStdTweenHandle UMStdTweenFloat::StartTween(UMStdTweenSubsystem* Tweens, const FMStdTweenBinding& Binding, const FMStdTweenTiming& Timing)
+{
+	return Tweens->StartTween(Binding, From, To, Timing);
+}
+
+UMStdTweenVector* UMStdTweenVector::StdTweenVector(UObject* WorldContextObject, UObject* InTarget, FName InPropertyName, FVector InFrom, FVector InTo,
+                                                   float InOverSeconds, EMStdEase InEase, UCurveFloat* InCurve)
+{
+	const auto Instance = MStdTweenInternals::NewTween<UMStdTweenVector>(WorldContextObject);
+	if (!Instance) return nullptr;
+	Instance->InitTween(InTarget, InPropertyName, InOverSeconds, InEase, InCurve);
+	Instance->From = InFrom;
+	Instance->To = InTo;
+	return Instance;
+}
+
+FMStdTweenHandle UMStdTweenVector::StartTween(UMStdTweenSubsystem* Tweens, const FMStdTweenBinding& Binding, const FMStdTweenTiming& Timing)
+{
+	return Tweens->StartTween(Binding, From, To, Timing);
+}
+
+UMStdTweenRotator* UMStdTweenRotator::StdTweenRotator(UObject* WorldContextObject, UObject* InTarget, FName InPropertyName, FRotator InFrom, FRotator InTo,
+                                                      float InOverSeconds, EMStdEase InEase, UCurveFloat* InCurve)
+{
+	const auto Instance = MStdTweenInternals::NewTween<UMStdTweenRotator>(WorldContextObject);
+	if (!Instance) return nullptr;
+	Instance->InitTween(InTarget, InPropertyName, InOverSeconds, InEase, InCurve);
+	Instance->From = InFrom;
+	Instance->To = InTo;
+	return Instance;
+}
+
+FMStdTweenHandle UMStdTweenRotator::StartTween(UMStdTweenSubsystem* Tweens, const FMStdTweenBinding& Binding, const FMStdTweenTiming& Timing)
+{
+	return Tweens->StartTween(Binding, From, To, Timing);
+}
+
+UMStdTweenColor* UMStdTweenColor::StdTweenColor(UObject* WorldContextObject, UObject* InTarget, FName InPropertyName, FLinearColor InFrom,
+                                                FLinearColor InTo, float InOverSeconds, EMStdEase InEase, UCurveFloat* InCurve)
+{
+	const auto Instance = MStdTweenInternals::NewTween<UMStdTweenColor>(WorldContextObject);
+	if (!Instance) return nullptr;
+	Instance->InitTween(InTarget, InPropertyName, InOverSeconds, InEase, InCurve);
+	Instance->From = InFrom;
+	Instance->To = InTo;
+	return Instance;
+}
+
+FMStdTweenHandle UMStdTweenColor::StartTween(UMStdTweenSubsystem* Tweens, const FMStdTweenBinding& Binding, const FMStdTweenTiming& Timing)
+{
+	return Tweens->StartTween(Binding, From, To, Timing);
+}
+
+UMStdTweenTransform* UMStdTweenTransform::StdTweenTransform(UObject* WorldContextObject, UObject* InTarget, FName InPropertyName, FTransform InFrom,
+                                                            FTransform InTo, float InOverSeconds, EMStdEase InEase, UCurveFloat* InCurve)
+{
+	const auto Instance = MStdTweenInternals::NewTween<UMStdTweenTransform>(WorldContextObject);
+	if (!Instance) return nullptr;
+	Instance->InitTween(InTarget, InPropertyName, InOverSeconds, InEase, InCurve);
+	Instance->From = InFrom;
+	Instance->To = InTo;
+	return Instance;
+}
+
+FMStdTweenHandle UMStdTweenTransform::StartTween(UMStdTweenSubsystem* Tweens, const FMStdTweenBinding& Binding, const FMStdTweenTiming& Timing)
+{
+	return Tweens->StartTween(Binding, From, To, Timing);
+}
@@ -0,0 +1,602 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Standard/Tween/MStdTweenSubsystem.h"
+#include "MTasksLog.h"
+#include "Camera/CameraComponent.h"
+#include "Components/ActorComponent.h"
+#include "Components/SceneComponent.h"
+#include "Curves/CurveFloat.h"
+#include "Engine/World.h"
+
+namespace MStdTweenSubsystemInternals
+{
+	enum EChannel : int32
+	{
+		CameraChannel,
+		FloatChannel,
+		VectorChannel,
+		RotatorChannel,
+		ColorChannel,
+		TransformChannel,
+	};
+
+	constexpr int32 ChannelBits = 3;
+	constexpr int32 ChannelMask = (1 << ChannelBits) - 1;
+
+	int32 GetChannel(int32 Id)
+	{
+		return Id & ChannelMask;
+	}
+
+	template <typename T>
+	bool IsStructProperty(const FProperty* Property)
+	{
+		const auto StructProperty = CastField<FStructProperty>(Property);
+		return StructProperty && StructProperty->Struct == TBaseStructure<T>::Get();
+	}
+
+	/** Check a binding can take a value; components are only valid targets for transform-like values */
+	bool CheckBinding(const FMStdTweenBinding& Binding, bool PropertyMatches, bool AllowComponent, const TCHAR* TypeName)
+	{
+		const auto Object = Binding.Object.Get();
+		if (!Object)
+		{
+			UE_LOG(LogMTasks, Warning, TEXT("UMStdTweenSubsystem: Invalid tween target: null"));
+			return false;
+		}
+		if (Binding.Property)
+		{
+			if (PropertyMatches) return true;
+			UE_LOG(LogMTasks, Warning, TEXT("UMStdTweenSubsystem: Property %s on %s is not a %s"), *Binding.Property->GetName(), *Object->GetName(), TypeName);
+			return false;
+		}
+		if (AllowComponent && Object->IsA<USceneComponent>()) return true;
+		UE_LOG(LogMTasks, Warning, TEXT("UMStdTweenSubsystem: %s has no %s to tween; name a property"), *Object->GetName(), TypeName);
+		return false;
+	}
+
+	/** Advance every slot and store its eased alpha; returns true if any slot finished */
+	template <typename TValue>
+	bool Advance(TMStdTweenChannel<TValue>& Channel, float DeltaTime)
+	{
+		auto AnyFinished = false;
+		for (auto i = 0; i < Channel.Num(); i++)
+		{
+			Channel.Elapsed[i] += DeltaTime;
+			const auto Duration = Channel.Durations[i];
+			const auto Linear = Duration > 0 ? FMath::Min(Channel.Elapsed[i] / Duration, 1.0f) : 1.0f;
+			AnyFinished |= Linear >= 1.0f;
+			Channel.Alphas[i] = UMStdTweenSubsystem::EvaluateEase(Channel.Eases[i], Channel.Curves[i].Get(), Linear);
+		}
+		return AnyFinished;
+	}
+
+	/** Floats are batched four tweens to a register */
+	void Interpolate(TMStdTweenChannel<float>& Channel)
+	{
+		const auto Count = Channel.Num();
+		const auto From = Channel.From.GetData();
+		const auto To = Channel.To.GetData();
+		const auto Alphas = Channel.Alphas.GetData();
+		const auto Values = Channel.Values.GetData();
+
+		auto i = 0;
+		for (; i + 4 <= Count; i += 4)
+		{
+			const auto A = VectorLoad(From + i);
+			const auto B = VectorLoad(To + i);
+			const auto Alpha = VectorLoad(Alphas + i);
+			VectorStore(VectorMultiplyAdd(VectorSubtract(B, A), Alpha, A), Values + i);
+		}
+		for (; i < Count; i++)
+		{
+			Values[i] = FMath::Lerp(From[i], To[i], Alphas[i]);
+		}
+	}
+
+	/**
+	 * Vectors, rotators and colors are one register per tween, not batched across tweens; a value already
+	 * fills all four lanes, so a struct-of-arrays transpose would do the same number of multiply-adds.
+	 */
+	void Interpolate(TMStdTweenChannel<FVector4>& Channel)
+	{
+		const auto Count = Channel.Num();
+		for (auto i = 0; i < Count; i++)
+		{
+			const auto A = VectorLoad(&Channel.From[i]);
+			const auto B = VectorLoad(&Channel.To[i]);
+			const auto Alpha = VectorLoadFloat1(&Channel.Alphas[i]);
+			VectorStore(VectorMultiplyAdd(VectorSubtract(B, A), Alpha, A), &Channel.Values[i]);
+		}
+	}
+
+	/** Transforms are a register per component of each tween, with the rotation as a quaternion lerp */
+	void Interpolate(TMStdTweenChannel<FMStdTweenTransformValue>& Channel)
+	{
+		const auto Count = Channel.Num();
+		for (auto i = 0; i < Count; i++)
+		{
+			const auto& From = Channel.From[i];
+			const auto& To = Channel.To[i];
+			auto& Value = Channel.Values[i];
+			const auto Alpha = VectorLoadFloat1(&Channel.Alphas[i]);
+
+			const auto FromTranslation = VectorLoad(&From.Translation);
+			VectorStore(VectorMultiplyAdd(VectorSubtract(VectorLoad(&To.Translation), FromTranslation), Alpha, FromTranslation), &Value.Translation);
+
+			const auto FromScale = VectorLoad(&From.Scale);
+			VectorStore(VectorMultiplyAdd(VectorSubtract(VectorLoad(&To.Scale), FromScale), Alpha, FromScale), &Value.Scale);
+
+			const auto Rotation = VectorLerpQuat(VectorLoad(&From.Rotation), VectorLoad(&To.Rotation), Alpha);
+			VectorStore(VectorNormalizeQuaternion(Rotation), &Value.Rotation);
+		}
+	}
+
+	/**
+	 * Write a property through its setter if it has one, otherwise directly; a direct write to a component
+	 * marks its render state dirty, since nothing else tells the renderer the value changed.
+	 */
+	template <typename T>
+	void SetProperty(UObject* Object, const FMStdTweenBinding& Binding, const T& Value)
+	{
+		if (Binding.Setter)
+		{
+			// The setter takes only the value, so its parameter block is just that
+			auto Params = Value;
+			Object->ProcessEvent(Binding.Setter, &Params);
+			return;
+		}
+		*Binding.Property->ContainerPtrToValuePtr<T>(Object) = Value;
+		if (const auto Component = Cast<UActorComponent>(Object))
+		{
+			Component->MarkRenderStateDirty();
+		}
+	}
+
+	void ApplyFloat(UObject* Object, const FMStdTweenBinding& Binding, const float& Value)
+	{
+		SetProperty(Object, Binding, Value);
+	}
+
+	void ApplyVector(UObject* Object, const FMStdTweenBinding& Binding, const FVector4& Value)
+	{
+		const auto Location = FVector(Value);
+		if (Binding.Property)
+		{
+			SetProperty(Object, Binding, Location);
+			return;
+		}
+		CastChecked<USceneComponent>(Object)->SetRelativeLocation(Location, false, nullptr, ETeleportType::TeleportPhysics);
+	}
+
+	void ApplyRotator(UObject* Object, const FMStdTweenBinding& Binding, const FVector4& Value)
+	{
+		const auto Rotation = FRotator(Value.X, Value.Y, Value.Z);
+		if (Binding.Property)
+		{
+			SetProperty(Object, Binding, Rotation);
+			return;
+		}
+		CastChecked<USceneComponent>(Object)->SetRelativeRotation(Rotation, false, nullptr, ETeleportType::TeleportPhysics);
+	}
+
+	void ApplyColor(UObject* Object, const FMStdTweenBinding& Binding, const FVector4& Value)
+	{
+		SetProperty(Object, Binding, FLinearColor(Value.X, Value.Y, Value.Z, Value.W));
+	}
+
+	void ApplyTransform(UObject* Object, const FMStdTweenBinding& Binding, const FMStdTweenTransformValue& Value)
+	{
+		const auto Transform = FTransform(Value.Rotation, FVector(Value.Translation), FVector(Value.Scale));
+		if (Binding.Property)
+		{
+			SetProperty(Object, Binding, Transform);
+			return;
+		}
+		CastChecked<USceneComponent>(Object)->SetRelativeTransform(Transform, false, nullptr, ETeleportType::TeleportPhysics);
+	}
+
+	/** Write every value to its binding; returns true if any target has gone away */
+	template <typename TValue, typename TApply>
+	bool ApplyAll(const TMStdTweenChannel<TValue>& Channel, TApply Apply)
+	{
+		auto AnyLost = false;
+		for (auto i = 0; i < Channel.Num(); i++)
+		{
+			const auto& Binding = Channel.Bindings[i];
+			if (const auto Object = Binding.Object.Get())
+			{
+				Apply(Object, Binding, Channel.Values[i]);
+			}
+			else
+			{
+				AnyLost = true;
+			}
+		}
+		return AnyLost;
+	}
+
+	/** Drop finished tweens, and tweens whose target has gone away */
+	template <typename TValue>
+	void Prune(TMStdTweenChannel<TValue>& Channel)
+	{
+		for (auto i = Channel.Num() - 1; i >= 0; i--)
+		{
+			if (Channel.Elapsed[i] >= Channel.Durations[i] || !Channel.Bindings[i].Object.IsValid())
+			{
+				Channel.RemoveAtSwap(i);
+			}
+		}
+	}
+
+	template <typename TValue, typename TApply>
+	void TickChannel(TMStdTweenChannel<TValue>& Channel, float DeltaTime, TApply Apply)
+	{
+		if (Channel.Num() == 0) return;
+		const auto AnyFinished = Advance(Channel, DeltaTime);
+		Interpolate(Channel);
+		const auto AnyLost = ApplyAll(Channel, Apply);
+		if (AnyFinished || AnyLost)
+		{
+			Prune(Channel);
+		}
+	}
+
+	template <typename TValue, typename TApply>
+	void StopChannelTween(TMStdTweenChannel<TValue>& Channel, int32 Id, bool JumpToEnd, TApply Apply)
+	{
+		const auto Index = Channel.IndexById.Find(Id);
+		if (!Index) return;
+
+		const auto& Binding = Channel.Bindings[*Index];
+		const auto Object = Binding.Object.Get();
+		if (JumpToEnd && Object)
+		{
+			Apply(Object, Binding, Channel.To[*Index]);
+		}
+		Channel.RemoveAtSwap(*Index);
+	}
+
+	FVector4 RotatorToVector(const FRotator& Rotator)
+	{
+		return FVector4(Rotator.Pitch, Rotator.Yaw, Rotator.Roll, 0);
+	}
+
+	FMStdTweenTransformValue WidenTransform(const FTransform& Transform)
+	{
+		FMStdTweenTransformValue Value;
+		Value.Translation = FVector4(Transform.GetTranslation(), 0);
+		Value.Rotation = Transform.GetRotation();
+		Value.Scale = FVector4(Transform.GetScale3D(), 0);
+		return Value;
+	}
+}
+
+FMStdTweenBinding FMStdTweenBinding::ForProperty(UObject* Object, FName PropertyName)
+{
+	FMStdTweenBinding Binding;
+	if (!Object) return Binding;
+
+	if (!PropertyName.IsNone())
+	{
+		Binding.Property = FindFProperty<FProperty>(Object->GetClass(), PropertyName);
+		if (!Binding.Property)
+		{
+			UE_LOG(LogMTasks, Warning, TEXT("UMStdTweenSubsystem: %s has no property %s"), *Object->GetName(), *PropertyName.ToString());
+			return Binding;
+		}
+
+		// Only a setter whose single parameter has the property's type; ProcessEvent can't fill in defaults
+		const auto Setter = Object->FindFunction(*FString::Printf(TEXT("Set%s"), *PropertyName.ToString()));
+		if (Setter && Setter->NumParms == 1)
+		{
+			const auto Param = *TFieldIterator<FProperty>(Setter);
+			if (Param && !Param->HasAnyPropertyFlags(CPF_OutParm | CPF_ReturnParm) && Param->SameType(Binding.Property))
+			{
+				Binding.Setter = Setter;
+			}
+		}
+	}
+
+	Binding.Object = Object;
+	return Binding;
+}
+
+UMStdTweenSubsystem* UMStdTweenSubsystem::Get(const UObject* WorldContextObject)
+{
+	const auto World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<UMStdTweenSubsystem>() : nullptr;
+}
+
+FMStdTweenHandle UMStdTweenSubsystem::StartTransformTween(const FMStdTransformTween& Tween)
+{
+	FMStdTweenHandle Handle;
+	if (!Tween.Target)
+	{
+		UE_LOG(LogMTasks, Warning, TEXT("UMStdTweenSubsystem: Invalid tween target: null"));
+		return Handle;
+	}
+
+	// Only one tween per component, or they fight each other
+	for (auto i = TransformTweens.Num() - 1; i >= 0; i--)
+	{
+		if (TransformTweens[i].Target == Tween.Target)
+		{
+			RemoveTransformTweenAt(i);
+		}
+	}
+
+	Handle.Id = MakeId(MStdTweenSubsystemInternals::CameraChannel);
+
+	FMStdTransformTweenState State;
+	State.Id = Handle.Id;
+	State.Target = Tween.Target;
+	State.Curve = Tween.Curve;
+	State.Tween = Tween;
+	State.Tween.Target = nullptr;
+	State.Tween.Curve = nullptr;
+	State.FromQuat = Tween.FromRotation.Quaternion();
+	State.ToQuat = Tween.ToRotation.Quaternion();
+	TransformTweenIndex.Add(Handle.Id, TransformTweens.Add(State));
+
+	ApplyTransformTween(State, 0);
+	return Handle;
+}
+
+FMStdTweenHandle UMStdTweenSubsystem::StartTween(const FMStdTweenBinding& Binding, float From, float To, const FMStdTweenTiming& Timing)
+{
+	using namespace MStdTweenSubsystemInternals;
+	FMStdTweenHandle Handle;
+	if (!CheckBinding(Binding, Binding.Property && Binding.Property->IsA<FFloatProperty>(), false, TEXT("float"))) return Handle;
+
+	Handle.Id = MakeId(FloatChannel);
+	FloatTweens.Add(Handle.Id, Binding, Timing, From, To);
+	ApplyFloat(Binding.Object.Get(), Binding, From);
+	return Handle;
+}
+
+FMStdTweenHandle UMStdTweenSubsystem::StartTween(const FMStdTweenBinding& Binding, const FVector& From, const FVector& To, const FMStdTweenTiming& Timing)
+{
+	using namespace MStdTweenSubsystemInternals;
+	FMStdTweenHandle Handle;
+	if (!CheckBinding(Binding, IsStructProperty<FVector>(Binding.Property), true, TEXT("vector"))) return Handle;
+
+	Handle.Id = MakeId(VectorChannel);
+	VectorTweens.Add(Handle.Id, Binding, Timing, FVector4(From, 0), FVector4(To, 0));
+	ApplyVector(Binding.Object.Get(), Binding, FVector4(From, 0));
+	return Handle;
+}
+
+FMStdTweenHandle UMStdTweenSubsystem::StartTween(const FMStdTweenBinding& Binding, const FRotator& From, const FRotator& To, const FMStdTweenTiming& Timing)
+{
+	using namespace MStdTweenSubsystemInternals;
+	FMStdTweenHandle Handle;
+	if (!CheckBinding(Binding, IsStructProperty<FRotator>(Binding.Property), true, TEXT("rotator"))) return Handle;
+
+	// Lerp per axis towards an end point along the shortest path
+	const auto ShortestTo = From + (To - From).GetNormalized();
+
+	Handle.Id = MakeId(RotatorChannel);
+	RotatorTweens.Add(Handle.Id, Binding, Timing, RotatorToVector(From), RotatorToVector(ShortestTo));
+	ApplyRotator(Binding.Object.Get(), Binding, RotatorToVector(From));
+	return Handle;
+}
+
+FMStdTweenHandle UMStdTweenSubsystem::StartTween(const FMStdTweenBinding& Binding, const FLinearColor& From, const FLinearColor& To, const FMStdTweenTiming& Timing)
+{
+	using namespace MStdTweenSubsystemInternals;
+	FMStdTweenHandle Handle;
+	if (!CheckBinding(Binding, IsStructProperty<FLinearColor>(Binding.Property), false, TEXT("color"))) return Handle;
+
+	const auto FromValue = FVector4(From.R, From.G, From.B, From.A);
+	Handle.Id = MakeId(ColorChannel);
+	ColorTweens.Add(Handle.Id, Binding, Timing, FromValue, FVector4(To.R, To.G, To.B, To.A));
+	ApplyColor(Binding.Object.Get(), Binding, FromValue);
+	return Handle;
+}
+
+FMStdTweenHandle UMStdTweenSubsystem::StartTween(const FMStdTweenBinding& Binding, const FTransform& From, const FTransform& To, const FMStdTweenTiming& Timing)
+{
+	using namespace MStdTweenSubsystemInternals;
+	FMStdTweenHandle Handle;
+	if (!CheckBinding(Binding, IsStructProperty<FTransform>(Binding.Property), true, TEXT("transform"))) return Handle;
+
+	const auto FromValue = WidenTransform(From);
+	Handle.Id = MakeId(TransformChannel);
+	ValueTransformTweens.Add(Handle.Id, Binding, Timing, FromValue, WidenTransform(To));
+	ApplyTransform(Binding.Object.Get(), Binding, FromValue);
+	return Handle;
+}
+
+void UMStdTweenSubsystem::StopTween(FMStdTweenHandle Handle, bool JumpToEnd)
+{
+	using namespace MStdTweenSubsystemInternals;
+	switch (GetChannel(Handle.Id))
+	{
+	case CameraChannel:
+		if (const auto Index = TransformTweenIndex.Find(Handle.Id))
+		{
+			if (JumpToEnd)
+			{
+				ApplyTransformTween(TransformTweens[*Index], 1);
+			}
+			RemoveTransformTweenAt(*Index);
+		}
+		break;
+	case FloatChannel:
+		StopChannelTween(FloatTweens, Handle.Id, JumpToEnd, ApplyFloat);
+		break;
+	case VectorChannel:
+		StopChannelTween(VectorTweens, Handle.Id, JumpToEnd, ApplyVector);
+		break;
+	case RotatorChannel:
+		StopChannelTween(RotatorTweens, Handle.Id, JumpToEnd, ApplyRotator);
+		break;
+	case ColorChannel:
+		StopChannelTween(ColorTweens, Handle.Id, JumpToEnd, ApplyColor);
+		break;
+	case TransformChannel:
+		StopChannelTween(ValueTransformTweens, Handle.Id, JumpToEnd, ApplyTransform);
+		break;
+	default:
+		break;
+	}
+}
+
+bool UMStdTweenSubsystem::IsTweenActive(FMStdTweenHandle Handle) const
+{
+	using namespace MStdTweenSubsystemInternals;
+	switch (GetChannel(Handle.Id))
+	{
+	case CameraChannel:
+		return TransformTweenIndex.Contains(Handle.Id);
+	case FloatChannel:
+		return FloatTweens.IndexById.Contains(Handle.Id);
+	case VectorChannel:
+		return VectorTweens.IndexById.Contains(Handle.Id);
+	case RotatorChannel:
+		return RotatorTweens.IndexById.Contains(Handle.Id);
+	case ColorChannel:
+		return ColorTweens.IndexById.Contains(Handle.Id);
+	case TransformChannel:
+		return ValueTransformTweens.IndexById.Contains(Handle.Id);
+	default:
+		return false;
+	}
+}
+
+float UMStdTweenSubsystem::EvaluateEase(EMStdEase Ease, const UCurveFloat* Curve, float Alpha)
+{
+	Alpha = FMath::Clamp(Alpha, 0.0f, 1.0f);
+	if (Curve)
+	{
+		return Curve->GetFloatValue(Alpha);
+	}
+
+	switch (Ease)
+	{
+	case EMStdEase::EaseIn:
+		return Alpha * Alpha;
+	case EMStdEase::EaseOut:
+		return Alpha * (2.0f - Alpha);
+	case EMStdEase::EaseInOut:
+		return Alpha * Alpha * (3.0f - 2.0f * Alpha);
+	default:
+		return Alpha;
+	}
+}
+
+void UMStdTweenSubsystem::Tick(float DeltaTime)
+{
+	TickTransformTweens(DeltaTime);
+	TickValueTweens(DeltaTime);
+}
+
+bool UMStdTweenSubsystem::IsTickable() const
+{
+	if (HasAnyFlags(RF_ClassDefaultObject)) return false;
+	return TransformTweens.Num() > 0
+		|| FloatTweens.Num() > 0
+		|| VectorTweens.Num() > 0
+		|| RotatorTweens.Num() > 0
+		|| ColorTweens.Num() > 0
+		|| ValueTransformTweens.Num() > 0;
+}
+
+UWorld* UMStdTweenSubsystem::GetTickableGameObjectWorld() const
+{
+	return GetWorld();
+}
+
+TStatId UMStdTweenSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UMStdTweenSubsystem, STATGROUP_Tickables);
+}
+
+void UMStdTweenSubsystem::TickTransformTweens(float DeltaTime)
+{
+	for (auto i = TransformTweens.Num() - 1; i >= 0; i--)
+	{
+		if (!TransformTweens[i].Tween.AdvancedByOwner)
+		{
+			StepTransformTween(i, DeltaTime);
+		}
+	}
+}
+
+bool UMStdTweenSubsystem::AdvanceTween(FMStdTweenHandle Handle, float DeltaTime)
+{
+	const auto Index = TransformTweenIndex.Find(Handle.Id);
+	return Index && StepTransformTween(*Index, DeltaTime);
+}
+
+bool UMStdTweenSubsystem::StepTransformTween(int32 Index, float DeltaTime)
+{
+	auto& State = TransformTweens[Index];
+	if (!State.Target.IsValid())
+	{
+		RemoveTransformTweenAt(Index);
+		return false;
+	}
+
+	State.Elapsed += DeltaTime;
+	const auto Alpha = State.Tween.Duration > 0 ? State.Elapsed / State.Tween.Duration : 1.0f;
+	ApplyTransformTween(State, Alpha);
+	if (Alpha >= 1.0f)
+	{
+		RemoveTransformTweenAt(Index);
+		return false;
+	}
+	return true;
+}
+
+void UMStdTweenSubsystem::TickValueTweens(float DeltaTime)
+{
+	using namespace MStdTweenSubsystemInternals;
+	TickChannel(FloatTweens, DeltaTime, ApplyFloat);
+	TickChannel(VectorTweens, DeltaTime, ApplyVector);
+	TickChannel(RotatorTweens, DeltaTime, ApplyRotator);
+	TickChannel(ColorTweens, DeltaTime, ApplyColor);
+	TickChannel(ValueTransformTweens, DeltaTime, ApplyTransform);
+}
+
+void UMStdTweenSubsystem::ApplyTransformTween(const FMStdTransformTweenState& State, float Alpha)
+{
+	const auto Target = State.Target.Get();
+	if (!Target) return;
+
+	const auto& Tween = State.Tween;
+	const auto Eased = EvaluateEase(Tween.Ease, State.Curve.Get(), Alpha);
+
+	if (Tween.TweenLocation || Tween.TweenRotation)
+	{
+		const auto Location = Tween.TweenLocation ? FMath::Lerp(Tween.FromLocation, Tween.ToLocation, Eased) : Target->GetRelativeLocation();
+		const auto Rotation = Tween.TweenRotation ? FQuat::Slerp(State.FromQuat, State.ToQuat, Eased) : Target->GetRelativeRotation().Quaternion();
+		Target->SetRelativeLocationAndRotation(Location, Rotation, false, nullptr, ETeleportType::TeleportPhysics);
+	}
+
+	if (Tween.TweenFieldOfView)
+	{
+		if (const auto Camera = Cast<UCameraComponent>(Target))
+		{
+			Camera->SetFieldOfView(FMath::Lerp(Tween.FromFieldOfView, Tween.ToFieldOfView, Eased));
+		}
+	}
+}
+
+void UMStdTweenSubsystem::RemoveTransformTweenAt(int32 Index)
+{
+	TransformTweenIndex.Remove(TransformTweens[Index].Id);
+	TransformTweens.RemoveAtSwap(Index);
+	if (Index < TransformTweens.Num())
+	{
+		TransformTweenIndex.Add(TransformTweens[Index].Id, Index);
+	}
+}
+
+int32 UMStdTweenSubsystem::MakeId(int32 Channel)
+{
+	NextSerial += 1;
+	return (NextSerial << MStdTweenSubsystemInternals::ChannelBits) | Channel;
+}
@@ -0,0 +1,98 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MTask.h"
+
+class UMTaskExecutor;
+
+/** A task or command in a graph snapshot */
+struct MTASKS_API FMTaskGraphNode
+{
+	TWeakObjectPtr<UObject> Object;
+
+	FString Name;
+
+	FString ClassName;
+
+	EMTaskState State = EMTaskState::Idle;
+
+	bool IsCommand = false;
+
+	/** Index of the parent node, or INDEX_NONE for a root */
+	int32 Parent = INDEX_NONE;
+
+	/** The parent state this node runs on; Idle for commands and roots */
+	EMTaskState Edge = EMTaskState::Idle;
+
+	TArray<int32> Children;
+
+	/** Seconds from the earliest event in the snapshot; negative when the event log has no record of it */
+	double StartTime = -1;
+
+	double EndTime = -1;
+
+	/** Seconds from start to completion, or to the snapshot for anything still running */
+	double Duration = 0;
+
+	/** The longest duration from the start of this node to the end of any descendant that runs; the branch a parent didn't take is skipped */
+	double PathDuration = 0;
+
+	bool IsOnCriticalPath = false;
+
+	bool HasTiming() const
+	{
+		return StartTime >= 0;
+	}
+};
+
+/** A run of tasks chained one after another, each the only child of the one before */
+struct MTASKS_API FMTaskGraphChain
+{
+	TArray<int32> Nodes;
+
+	/** End to end, as chained */
+	double SerialDuration = 0;
+
+	/** End to end if the links were independent and fanned out from the first; the longest single link */
+	double ParallelDuration = 0;
+};
+
+/**
+ * A snapshot of the live task graphs in an executor: every running or pending task, the `Then`
+ * chains above and below it, and any command parented to them.
+ *
+ * Durations come from the executor's event log, so nothing extra is measured while tasks run;
+ * nodes which have scrolled out of the log have no timing.
+ */
+class MTASKS_API FMTaskGraph
+{
+public:
+	TArray<FMTaskGraphNode> Nodes;
+
+	TArray<int32> Roots;
+
+	/** Root to leaf, the chain with the longest end to end duration */
+	TArray<int32> CriticalPath;
+
+	double CriticalPathDuration = 0;
+
+	/** Chains long enough to be worth fanning out, if their links don't depend on each other */
+	TArray<FMTaskGraphChain> SerialChains;
+
+	/** Snapshot the live graphs in an executor and analyze them */
+	static FMTaskGraph Capture(const UMTaskExecutor& Executor);
+
+	/** Compute path durations, the critical path and serial chains; Capture calls this */
+	void Analyze(int32 MinChainLength = 3);
+
+	/** Write a summary; the critical path, serial chains and, if IncludeTree is set, every node */
+	void Dump(FOutputDevice& Out, bool IncludeTree) const;
+
+	/** The graph in Graphviz dot format, with the critical path highlighted */
+	FString ToDot() const;
+
+private:
+	int32 AddNode(UObject* Object, bool IsCommand, TMap<const UObject*, int32>& Index);
+};
@@ -0,0 +1,91 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MCommand.h"
+#include "MBatchCommand.generated.h"
+
+/**
+ * Packed per-agent state for a batch command.
+ * Removal swaps the last agent into the hole, so indices are only stable between removals.
+ */
+template <typename TState>
+struct TMBatchAgents
+{
+	TArray<TState> States;
+
+	int32 Num() const
+	{
+		return States.Num();
+	}
+
+	int32 Add(const TState& State)
+	{
+		return States.Add(State);
+	}
+
+	void RemoveAtSwap(int32 Index)
+	{
+		States.RemoveAtSwap(Index, 1, false);
+	}
+
+	/** Remove every agent matching the predicate; returns how many were removed */
+	template <typename TPredicate>
+	int32 RemoveAllSwap(TPredicate Predicate)
+	{
+		return States.RemoveAllSwap(Predicate, false);
+	}
+
+	/** The agents in [Begin, End) */
+	TArrayView<TState> Range(int32 Begin, int32 End)
+	{
+		return TArrayView<TState>(States.GetData() + Begin, End - Begin);
+	}
+};
+
+/**
+ * A single command that runs many identical agents.
+ *
+ * Instead of one command (one UObject, one executor entry, one poll) per agent, keep the
+ * agents in a TMBatchAgents inside one batch command, and poll them together:
+ *
+ *   TMBatchAgents<FMyAgent> Agents;
+ *   virtual int32 GetBatchNum() const override { return Agents.Num(); }
+ *   virtual void OnPollBatch(int32 Begin, int32 End, float DeltaTime) override
+ *   {
+ *       for (auto& Agent : Agents.Range(Begin, End)) { ... }
+ *   }
+ *
+ * With ParallelChunkSize set, OnPollBatch is called for each chunk from a ParallelFor, so it
+ * must only touch the agents in its range. Anything needing the game thread, like removing
+ * finished agents or applying results to actors, belongs in OnBatchPolled.
+ */
+UCLASS(Abstract)
+class MTASKS_API UMBatchCommand : public UMCommand
+{
+	GENERATED_BODY()
+
+public:
+	/** Agents per parallel job; 0 polls the whole batch on the game thread */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "MTasks")
+	int32 ParallelChunkSize = 0;
+
+	/** Resolve the command once it has no agents left */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "MTasks")
+	bool ResolveWhenEmpty = true;
+
+	virtual EMTaskState OnPoll_Implementation(float DeltaTime) override;
+
+protected:
+	/** How many agents are in the batch */
+	virtual int32 GetBatchNum() const PURE_VIRTUAL(UMBatchCommand::GetBatchNum, return 0;);
+
+	/** Poll the agents in [Begin, End) */
+	virtual void OnPollBatch(int32 Begin, int32 End, float DeltaTime) PURE_VIRTUAL(UMBatchCommand::OnPollBatch,);
+
+	/** Invoked on the game thread once every agent was polled */
+	virtual void OnBatchPolled(float DeltaTime)
+	{
+	}
+};
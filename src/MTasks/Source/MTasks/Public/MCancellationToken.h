@@ -0,0 +1,39 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "MCancellationToken.generated.h"
+
+/**
+ * A cancellation token can be shared by any number of tasks and commands.
+ *
+ * Cancelling the token rejects every task or command holding it the next time
+ * the executor reaches it; no scan of the executor is required. Child tasks
+ * inherit the token of their parent when they start, unless they have their own.
+ */
+UCLASS(BlueprintType)
+class MTASKS_API UMCancellationToken : public UObject
+{
+	GENERATED_BODY()
+
+private:
+	bool Cancelled = false;
+
+public:
+	/** Create a new, uncancelled token */
+	UFUNCTION(BlueprintCallable, Category="MTasks", meta=(WorldContext="WorldContextObject"))
+	static UMCancellationToken* CreateToken(UObject* WorldContextObject);
+
+	/** Cancel every task and command that holds this token */
+	UFUNCTION(BlueprintCallable, Category="MTasks")
+	void Cancel();
+
+	/** Has this token been cancelled? */
+	UFUNCTION(BlueprintCallable, Category="MTasks")
+	bool IsCancelled() const
+	{
+		return Cancelled;
+	}
+};
@@ -4,9 +4,11 @@
 
 #include "CoreMinimal.h"
 #include "MTask.h"
+#include "MCancellationToken.h"
 #include "UObject/Object.h"
 #include "MCommand.generated.h"
 
+class FMTaskQueryCache;
 class UMCommand;
 DECLARE_MULTICAST_DELEGATE_OneParam(FCommandUpdate, UMCommand*);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FCommandUpdateBP, UMCommand*, Command);
@@ -22,6 +24,8 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FCommandUpdateBP, UMCommand*, Comman
  *
  * You could create an actor for these, but a command does the job without polluting the actor
  * hierarchy. 
+ *
+ * The _Implementation methods are declared for the same reason as on UMTask.
  */
 UCLASS(Abstract, BlueprintAble, BlueprintType)
 class MTASKS_API UMCommand : public UObject
@@ -43,6 +47,37 @@ public:
 	UPROPERTY()
 	TWeakObjectPtr<UMTask> Parent = nullptr;
 
+	/** Polling priority; only read when the command is started */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "MTasks")
+	EMTaskPriority Priority = EMTaskPriority::Normal;
+
+	/**
+	 * Poll at most once every N ticks; 0 polls every tick. Only read when the command is started.
+	 * The DeltaTime passed to OnPoll is the total time since the last poll.
+	 */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "MTasks")
+	int PollIntervalTicks = 0;
+
+	/** Poll at most once every N seconds; 0 polls every tick. Only read when the command is started */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "MTasks")
+	float PollIntervalSeconds = 0;
+
+	/** The executor running this command; set when it is run */
+	UPROPERTY()
+	TWeakObjectPtr<UMTaskExecutor> OwningExecutor = nullptr;
+
+	/** Shared token which cancels this command */
+	UPROPERTY(BlueprintReadWrite, Category = "MTasks")
+	UMCancellationToken* CancellationToken = nullptr;
+
+	/** Taken off the executor's ready queues; see Suspend */
+	UPROPERTY(BlueprintReadOnly, Category = "MTasks")
+	bool Suspended = false;
+
+private:
+	/** Renewed since the executor last polled this command */
+	bool Renewed = false;
+
 public:
 	// Public API
 
@@ -54,6 +89,31 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "MTasks")
 	void Cancel(UMTaskExecutor* Executor);
 
+	/** Per-tick world query cache of the executor running this command; null if it is not running */
+	FMTaskQueryCache* GetQueryCache() const;
+
+	/**
+	 * Keep this command alive when the executor policy gives it a lease; see FMTaskCommandPolicy.
+	 * Renewing a suspended command resumes it.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "MTasks")
+	void Renew();
+
+	/** Stop polling this command until it is resumed or renewed, without ending it */
+	UFUNCTION(BlueprintCallable, Category = "MTasks")
+	void Suspend();
+
+	UFUNCTION(BlueprintCallable, Category = "MTasks")
+	void Resume();
+
+	/** Was this renewed since the last call? The executor calls this once per poll */
+	bool ConsumeRenewal();
+
+	/** Heap held by the invocation lists of this command's delegates */
+	SIZE_T GetDelegatesAllocatedSize() const;
+
+	virtual void GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize) override;
+
 	/** Is this command still un-started? ie. Idle or Waiting */
 	UFUNCTION(BlueprintCallable, Category = "MTasks")
 	FORCEINLINE bool IsPending()
@@ -85,6 +145,8 @@ public:
 	UFUNCTION(BlueprintNativeEvent, Category = "MTasks")
 	void OnStart(UObject* Context);
 
+	virtual void OnStart_Implementation(UObject* Context);
+
 	/**
 	 * Invoked when the command is completed; regardless of the state.
 	 * Use this to do a 'final' cleanup for things.
@@ -92,7 +154,11 @@ public:
 	UFUNCTION(BlueprintNativeEvent, Category = "MTasks")
 	void OnEnd();
 
+	virtual void OnEnd_Implementation();
+
 	/** Poll this command to update the state  */
 	UFUNCTION(BlueprintNativeEvent, Category = "MTasks")
 	EMTaskState OnPoll(float DeltaTime);
+
+	virtual EMTaskState OnPoll_Implementation(float DeltaTime);
 };
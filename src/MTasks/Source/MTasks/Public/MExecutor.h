@@ -3,11 +3,74 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "MCancellationToken.h"
 #include "MCommand.h"
 #include "MTask.h"
+#include "MTaskEventLog.h"
+#include "MTaskQueryCache.h"
 #include "UObject/Object.h"
 #include "MExecutor.generated.h"
 
+/** What the watchdog does to a task or command which keeps exceeding WatchdogThreshold */
+UENUM(BlueprintType)
+enum class EMTaskWatchdogAction : uint8
+{
+	/** Only log */
+	None,
+
+	/** Move it to the Low priority queue; it is polled only while there is tick budget left */
+	Demote,
+
+	/** Double its poll interval, in ticks and in seconds if it has one, each time it offends; up to 64 ticks or 1 second */
+	Throttle,
+
+	/** Reject it */
+	Reject,
+};
+
+/** What the executor does with tasks and commands that can never complete or that nothing is waiting on */
+UENUM(BlueprintType)
+enum class EMTaskOrphanAction : uint8
+{
+	/** Don't look for orphans */
+	None,
+
+	/** Log a summary of the orphans found by each scan */
+	Report,
+
+	/** Log them, and reject them so they are released */
+	Collect,
+};
+
+/** What the executor does to a command whose lease runs out */
+UENUM(BlueprintType)
+enum class EMTaskLeaseAction : uint8
+{
+	/** Reject it */
+	Reject,
+
+	/** Take it off the ready queues until it is renewed or resumed */
+	Suspend,
+};
+
+/** Limits for long running commands; see FMTaskExecutorPolicy::CommandPolicy */
+USTRUCT(BlueprintType)
+struct MTASKS_API FMTaskCommandPolicy
+{
+	GENERATED_BODY()
+
+	/** A running command must be renewed with UMCommand::Renew at least this often, in seconds; 0 for no lease */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="MTasks")
+	float LeaseSeconds = 0;
+
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="MTasks")
+	EMTaskLeaseAction LeaseAction = EMTaskLeaseAction::Reject;
+
+	/** Commands running longer than this are rejected, in seconds; 0 for unlimited */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="MTasks")
+	float MaxExecutionDuration = 0;
+};
+
 USTRUCT(BlueprintType)
 struct MTASKS_API FMTaskExecutorPolicy
 {
@@ -16,13 +79,214 @@ struct MTASKS_API FMTaskExecutorPolicy
 	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="MTasks")
 	bool UseCustomPolicy;
 
+	/** Tasks running longer than this are rejected, in seconds; 0 for unlimited */
 	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="MTasks")
 	float MaxExecutionDuration;
 
+	/** Leases and limits for every command without an entry in CommandPolicies */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="MTasks")
+	FMTaskCommandPolicy CommandPolicy;
+
+	/** Per-class overrides of CommandPolicy; the entry for the closest superclass wins. Read when a command is run */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="MTasks")
+	TMap<TSubclassOf<UMCommand>, FMTaskCommandPolicy> CommandPolicies;
+
+	/**
+	 * Seconds of polling allowed per tick; 0 for unlimited.
+	 * Once exceeded, tasks and commands below AlwaysPollPriority are deferred to the next tick.
+	 */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="MTasks")
+	float TickBudget;
+
+	/**
+	 * Tasks, and commands, polled per priority level per tick even when TickBudget is used up, so higher
+	 * priority work can't starve a level; polling resumes from the first deferred entry next tick.
+	 */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="MTasks")
+	int MinPollsPerLevel;
+
+	/** Tasks and commands at or above this priority are polled every tick, regardless of budget */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="MTasks")
+	EMTaskPriority AlwaysPollPriority;
+
+	/**
+	 * Admission control; the maximum number of tasks and commands started per tick, or 0 for unlimited.
+	 * When set, RunTask and RunCommand only queue the entry, and OnStart is called when it is admitted.
+	 */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="MTasks")
+	int MaxStartsPerTick;
+
+	/** Spread the first poll of newly admitted tasks and commands over this many ticks; 0 or 1 to disable */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="MTasks")
+	int SpreadFirstPollTicks;
+
+	/**
+	 * Scale work down when recent frames run over TargetFrameTime, and back up when there is headroom.
+	 * Below AlwaysPollPriority, entries are polled less often and get a smaller TickBudget; admission
+	 * (MaxStartsPerTick, if set) is lowered for everything.
+	 */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="MTasks")
+	bool Adaptive;
+
+	/** Adaptive policy; the frame time to stay under, in seconds */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="MTasks")
+	float TargetFrameTime;
+
+	/** Adaptive policy; the least throughput to keep when throttled, as a fraction of normal */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="MTasks")
+	float AdaptiveMinScale;
+
+	/** Log any single OnStart, OnPoll or OnEnd call that takes longer than this, in seconds; 0 disables timing */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="MTasks")
+	float WatchdogThreshold;
+
+	/** Slow polls allowed before WatchdogAction is applied; it is applied again on every slow poll after that */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="MTasks")
+	int WatchdogStrikes;
+
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="MTasks")
+	EMTaskWatchdogAction WatchdogAction;
+
+	/** Number of recent task and command events kept for DumpEventLog; 0 disables the event log */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="MTasks")
+	int EventLogSize;
+
+	/** Periodically look for orphans; see ScanForOrphans */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="MTasks")
+	EMTaskOrphanAction OrphanAction;
+
+	/** Seconds between orphan scans */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="MTasks")
+	float OrphanScanInterval;
+
+	/** A command with no listeners and no parent is an orphan once it has run this long, in seconds; 0 never */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="MTasks")
+	float UnboundCommandTimeout;
+
 	FMTaskExecutorPolicy()
 	{
 		UseCustomPolicy = false;
 		MaxExecutionDuration = 0;
+		TickBudget = 0;
+		MinPollsPerLevel = 1;
+		AlwaysPollPriority = EMTaskPriority::High;
+		MaxStartsPerTick = 0;
+		SpreadFirstPollTicks = 0;
+		Adaptive = false;
+		TargetFrameTime = 1.0f / 60.0f;
+		AdaptiveMinScale = 0.25f;
+		WatchdogThreshold = 0;
+		WatchdogStrikes = 3;
+		WatchdogAction = EMTaskWatchdogAction::None;
+		EventLogSize = 256;
+		OrphanAction = EMTaskOrphanAction::None;
+		OrphanScanInterval = 10;
+		UnboundCommandTimeout = 300;
+	}
+};
+
+/** What the executor did in its last tick, and what the adaptive policy decided */
+USTRUCT(BlueprintType)
+struct MTASKS_API FMTaskExecutorStats
+{
+	GENERATED_BODY()
+
+	/** Average of recent frame times, in seconds; only measured with an adaptive policy */
+	UPROPERTY(BlueprintReadOnly, Category="MTasks")
+	float AverageFrameTime = 0;
+
+	/** Fraction of normal throughput allowed; 1 when not throttled */
+	UPROPERTY(BlueprintReadOnly, Category="MTasks")
+	float ThrottleScale = 1;
+
+	/** Entries below AlwaysPollPriority are polled once every this many ticks */
+	UPROPERTY(BlueprintReadOnly, Category="MTasks")
+	int32 LowPriorityStride = 1;
+
+	UPROPERTY(BlueprintReadOnly, Category="MTasks")
+	float EffectiveTickBudget = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category="MTasks")
+	int32 EffectiveMaxStartsPerTick = 0;
+
+	/** Entries polled last tick */
+	UPROPERTY(BlueprintReadOnly, Category="MTasks")
+	int32 Polled = 0;
+
+	/** Entries that were due but deferred by the budget or the adaptive stride last tick */
+	UPROPERTY(BlueprintReadOnly, Category="MTasks")
+	int32 Deferred = 0;
+
+	/** Entries started last tick */
+	UPROPERTY(BlueprintReadOnly, Category="MTasks")
+	int32 Started = 0;
+
+	/** Wall time spent in the last tick, in seconds */
+	UPROPERTY(BlueprintReadOnly, Category="MTasks")
+	float TickTime = 0;
+
+	/** Orphans found by the last orphan scan */
+	UPROPERTY(BlueprintReadOnly, Category="MTasks")
+	int32 Orphans = 0;
+
+	/** Orphans rejected by every scan so far */
+	UPROPERTY(BlueprintReadOnly, Category="MTasks")
+	int32 OrphansCollected = 0;
+};
+
+/** Polling cost of one task or command class, measured while class profiling is on */
+USTRUCT(BlueprintType)
+struct MTASKS_API FMTaskClassCost
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category="MTasks")
+	int32 Polls = 0;
+
+	/** Total time spent in OnPoll, in seconds */
+	UPROPERTY(BlueprintReadOnly, Category="MTasks")
+	float Seconds = 0;
+
+	/** The slowest single OnPoll, in seconds */
+	UPROPERTY(BlueprintReadOnly, Category="MTasks")
+	float PeakSeconds = 0;
+};
+
+/** When a managed task or command is next due to be polled */
+USTRUCT()
+struct MTASKS_API FMTaskExecutorSchedule
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	int32 IntervalTicks = 0;
+
+	UPROPERTY()
+	float IntervalSeconds = 0;
+
+	UPROPERTY()
+	int64 NextPollTick = 0;
+
+	UPROPERTY()
+	double NextPollTime = 0;
+
+	/** Assigned on admission; keys the adaptive stride, so an entry keeps its turn however the queue around it changes */
+	UPROPERTY()
+	uint32 StrideSlot = 0;
+
+	FMTaskExecutorSchedule()
+	{
+	}
+
+	FMTaskExecutorSchedule(int32 InIntervalTicks, float InIntervalSeconds)
+	{
+		IntervalTicks = InIntervalTicks;
+		IntervalSeconds = InIntervalSeconds;
+	}
+
+	FORCEINLINE bool IsThrottled() const
+	{
+		return IntervalTicks > 1 || IntervalSeconds > 0;
 	}
 };
 
@@ -34,9 +298,33 @@ struct MTASKS_API FMTaskExecutorManagedTask
 	UPROPERTY()
 	bool Completed;
 
+	/** Has OnStart been called? Admission control may defer it */
+	UPROPERTY()
+	bool Started;
+
 	UPROPERTY()
 	float ExecutionDuration;
 
+	/** Time accumulated while this entry was deferred or throttled; passed on when it is next polled */
+	UPROPERTY()
+	float DeferredDeltaTime;
+
+	/** Priority captured when the entry was started */
+	UPROPERTY()
+	EMTaskPriority Priority;
+
+	/** Poll interval captured when the entry was started */
+	UPROPERTY()
+	FMTaskExecutorSchedule Schedule;
+
+	/** Polls which exceeded the watchdog threshold */
+	UPROPERTY()
+	int32 SlowPolls = 0;
+
+	/** Demoted by the watchdog; moved to the Low queue, and polled only while there is tick budget left */
+	UPROPERTY()
+	bool Demoted = false;
+
 	UPROPERTY()
 	UMTask* Task = nullptr;
 
@@ -47,7 +335,10 @@ struct MTASKS_API FMTaskExecutorManagedTask
 	FMTaskExecutorManagedTask()
 	{
 		Completed = true;
+		Started = false;
 		ExecutionDuration = 0;
+		DeferredDeltaTime = 0;
+		Priority = EMTaskPriority::Normal;
 		Task = nullptr;
 		TaskContext = nullptr;
 	}
@@ -55,7 +346,11 @@ struct MTASKS_API FMTaskExecutorManagedTask
 	FMTaskExecutorManagedTask(UMTask* InTask, UObject* InTaskContext)
 	{
 		Completed = false;
+		Started = false;
 		ExecutionDuration = 0;
+		DeferredDeltaTime = 0;
+		Priority = InTask->Priority;
+		Schedule = FMTaskExecutorSchedule(InTask->PollIntervalTicks, InTask->PollIntervalSeconds);
 		Task = InTask;
 		TaskContext = InTaskContext;
 	}
@@ -69,9 +364,41 @@ struct MTASKS_API FMTaskExecutorManagedCommand
 	UPROPERTY()
 	bool Completed;
 
+	/** Has OnStart been called? Admission control may defer it */
+	UPROPERTY()
+	bool Started;
+
 	UPROPERTY()
 	float ExecutionDuration;
 
+	/** Time accumulated while this entry was deferred or throttled; passed on when it is next polled */
+	UPROPERTY()
+	float DeferredDeltaTime;
+
+	/** Priority captured when the entry was started */
+	UPROPERTY()
+	EMTaskPriority Priority;
+
+	/** Poll interval captured when the entry was started */
+	UPROPERTY()
+	FMTaskExecutorSchedule Schedule;
+
+	/** Polls which exceeded the watchdog threshold */
+	UPROPERTY()
+	int32 SlowPolls = 0;
+
+	/** Demoted by the watchdog; moved to the Low queue, and polled only while there is tick budget left */
+	UPROPERTY()
+	bool Demoted = false;
+
+	/** Command policy resolved for this command's class when it was run */
+	UPROPERTY()
+	FMTaskCommandPolicy CommandPolicy;
+
+	/** Time polled since the command was last renewed */
+	UPROPERTY()
+	float SinceRenewed = 0;
+
 	UPROPERTY()
 	UMCommand* Command = nullptr;
 
@@ -82,7 +409,10 @@ struct MTASKS_API FMTaskExecutorManagedCommand
 	FMTaskExecutorManagedCommand()
 	{
 		Completed = true;
+		Started = false;
 		ExecutionDuration = 0;
+		DeferredDeltaTime = 0;
+		Priority = EMTaskPriority::Normal;
 		Command = nullptr;
 		TaskContext = nullptr;
 	}
@@ -90,12 +420,89 @@ struct MTASKS_API FMTaskExecutorManagedCommand
 	FMTaskExecutorManagedCommand(UMCommand* InCommand, UObject* InTaskContext)
 	{
 		Completed = false;
+		Started = false;
 		ExecutionDuration = 0;
+		DeferredDeltaTime = 0;
+		Priority = InCommand->Priority;
+		Schedule = FMTaskExecutorSchedule(InCommand->PollIntervalTicks, InCommand->PollIntervalSeconds);
 		Command = InCommand;
 		TaskContext = InTaskContext;
 	}
 };
 
+/** The tasks and commands running at a single priority level */
+USTRUCT()
+struct MTASKS_API FMTaskExecutorReadyQueue
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<FMTaskExecutorManagedTask> Tasks;
+
+	UPROPERTY()
+	TArray<FMTaskExecutorManagedCommand> Commands;
+
+	/** Where to resume polling tasks, if the last tick ran out of budget */
+	int32 TaskCursor = 0;
+
+	/** Where to resume polling commands, if the last tick ran out of budget */
+	int32 CommandCursor = 0;
+};
+
+/** Which lifecycle events a task or command class implements in blueprint */
+struct FMTaskScriptOverrides
+{
+	bool OnStart = false;
+	bool OnPoll = false;
+	bool OnEnd = false;
+};
+
+/** Approximate heap held by an executor, in bytes; the managed tasks and commands are not included */
+struct FMTaskExecutorMemory
+{
+	/** Entries in the ready queues */
+	SIZE_T ReadyQueues = 0;
+
+	/** Entries waiting to be admitted */
+	SIZE_T Pending = 0;
+
+	/** Suspended commands */
+	SIZE_T Suspended = 0;
+
+	SIZE_T EventLog = 0;
+
+	/** Script overrides, class costs, frame history and the query cache */
+	SIZE_T Caches = 0;
+
+	SIZE_T GetTotal() const
+	{
+		return ReadyQueues + Pending + Suspended + EventLog + Caches;
+	}
+};
+
+/** Approximate footprint of the live tasks or commands of one class, in bytes */
+struct FMTaskClassFootprint
+{
+	int32 Count = 0;
+
+	/** The UObjects themselves */
+	SIZE_T ObjectBytes = 0;
+
+	/** Children arrays; always 0 for commands */
+	SIZE_T ChildrenBytes = 0;
+
+	/** Delegate invocation lists */
+	SIZE_T DelegateBytes = 0;
+
+	/** How long the oldest of them has been running, in seconds; a hint for tasks that never complete */
+	float OldestSeconds = 0;
+
+	SIZE_T GetTotal() const
+	{
+		return ObjectBytes + ChildrenBytes + DelegateBytes;
+	}
+};
+
 /**
  * The executor is a single top level process for running tasks.
  */
@@ -108,6 +515,9 @@ public:
 	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="MTasks")
 	FMTaskExecutorPolicy Policy;
 
+	/** Number of ready queues; one per EMTaskPriority */
+	static constexpr int32 PriorityLevels = static_cast<int32>(EMTaskPriority::High) + 1;
+
 private:
 	bool IsActive;
 
@@ -115,22 +525,71 @@ private:
 
 	long ElapsedTicks;
 
+	/** Total DeltaTime seen by this executor; the clock for PollIntervalSeconds */
+	double ElapsedTime;
+
+	/** Advanced for each throttled entry admitted, to spread their polls across ticks */
+	uint32 StaggerCounter;
+
+	/** Advanced for each entry admitted while SpreadFirstPollTicks is set */
+	uint32 AdmittedCount;
+
+	/** Advanced for each entry admitted, to hand out StrideSlots */
+	uint32 StrideCounter;
+
+	/** Running tasks and commands, one queue per EMTaskPriority; polled highest first */
 	UPROPERTY()
-	TArray<FMTaskExecutorManagedTask> RunningTasks;
+	TArray<FMTaskExecutorReadyQueue> ReadyQueues;
 
 	UPROPERTY()
 	TArray<FMTaskExecutorManagedTask> PendingTasks;
 
 	UPROPERTY()
-	TArray<FMTaskExecutorManagedCommand> RunningCommands;
+	TArray<FMTaskExecutorManagedCommand> PendingCommands;
 
+	/** Commands taken off the ready queues by SuspendCommand or an expired lease; not polled until resumed */
 	UPROPERTY()
-	TArray<FMTaskExecutorManagedCommand> PendingCommands;
+	TArray<FMTaskExecutorManagedCommand> SuspendedCommands;
 	
 	// If this is true, new tasks must go into 'next' not 'current' or they will get lost
 	// due to being in the middle of a processing loop.
 	bool TaskCompletionInProgress;
 
+	/** When the current tick started; used to measure the tick budget */
+	double TickStartTime;
+
+	/** Clock the tick budget is measured with; FPlatformTime::Seconds unless replaced */
+	TFunction<double()> BudgetClock;
+
+	/** Per-class cache of blueprint overrides, so native tasks skip the reflection thunks */
+	mutable TMap<TWeakObjectPtr<UClass>, FMTaskScriptOverrides> ScriptOverrides;
+
+	/** World queries shared by everything polled in one tick */
+	FMTaskQueryCache QueryCache;
+
+	/** Recent frame times for the adaptive policy; a ring buffer */
+	TArray<float> FrameTimes;
+
+	int32 FrameTimeCursor;
+
+	/** The stats for the last tick; the adaptive policy's decisions live here too */
+	FMTaskExecutorStats Stats;
+
+	/** Time every OnPoll and attribute it to the class of the task or command */
+	bool ProfileClasses;
+
+	/** Polling cost per class, while ProfileClasses is set */
+	mutable TMap<TWeakObjectPtr<UClass>, FMTaskClassCost> ClassCosts;
+
+	/** ElapsedTime of the next periodic orphan scan */
+	double NextOrphanScan;
+
+	/** GetMemoryUsage().GetTotal() as last added to the memory stat */
+	SIZE_T ReportedMemory;
+
+	/** The last Policy.EventLogSize events; recorded whether or not VerboseLogging is set; mutable, as the const poll paths record transitions */
+	mutable FMTaskEventLog EventLog;
+
 public:
 	UFUNCTION(BlueprintCallable, Category="MTasks")
 	void Initialize(FMTaskExecutorPolicy InPolicy, bool InActive);
@@ -139,6 +598,13 @@ public:
 	UFUNCTION(BlueprintCallable, Category="MTasks")
 	void Tick(float DeltaTime);
 
+	/**
+	 * Tick, but feed the adaptive policy FrameTime instead of the engine's last frame time.
+	 * For executors ticked off the game frame, and for tests.
+	 */
+	UFUNCTION(BlueprintCallable, Category="MTasks")
+	void TickWithFrameTime(float DeltaTime, float FrameTime);
+
 	/** Start and stop this executor */
 	UFUNCTION(BlueprintCallable, Category="MTasks")
 	void SetActive(bool InActive);
@@ -146,6 +612,101 @@ public:
 	UFUNCTION(BlueprintCallable, Category="MTasks")
 	void SetDebug(bool InVerboseLogging);
 
+	/** Measure the tick budget with this clock instead of wall time, eg. to make budget tests deterministic */
+	void SetBudgetClock(TFunction<double()> InClock);
+
+	/** Write the recent event log to the output log */
+	UFUNCTION(BlueprintCallable, Category="MTasks")
+	void DumpEventLog() const;
+
+	/**
+	 * Save the recent event log as a Chrome trace (chrome://tracing, Perfetto) or a CSV timeline.
+	 * Relative filenames are saved under Saved/Profiling/MTasks; returns the full path, or empty on failure.
+	 */
+	UFUNCTION(BlueprintCallable, Category="MTasks")
+	FString ExportEventLog(const FString& Filename, bool AsCsv) const;
+
+	const FMTaskEventLog& GetEventLog() const
+	{
+		return EventLog;
+	}
+
+	/** Visit every live executor in World, or in every world if World is null; for diagnostics */
+	static void ForEachExecutor(UWorld* World, TFunctionRef<void(UMTaskExecutor&)> Visitor);
+
+	/** Visit every managed task, pending or running, that has not completed yet; for diagnostics */
+	void ForEachTask(TFunctionRef<void(const FMTaskExecutorManagedTask&)> Visitor) const;
+
+	/** Visit every managed command, pending or running, that has not completed yet; for diagnostics */
+	void ForEachCommand(TFunctionRef<void(const FMTaskExecutorManagedCommand&)> Visitor) const;
+
+	/** What the executor did in its last tick */
+	UFUNCTION(BlueprintCallable, Category="MTasks")
+	FMTaskExecutorStats GetStats() const
+	{
+		return Stats;
+	}
+
+	/** Ticks processed since the executor was created */
+	int64 GetElapsedTicks() const
+	{
+		return ElapsedTicks;
+	}
+
+	/** Running tasks and commands in the ready queue for a priority */
+	UFUNCTION(BlueprintCallable, Category="MTasks")
+	int32 GetQueueDepth(EMTaskPriority Priority) const;
+
+	/** Tasks and commands waiting to be admitted to a ready queue */
+	UFUNCTION(BlueprintCallable, Category="MTasks")
+	int32 GetPendingDepth() const
+	{
+		return PendingTasks.Num() + PendingCommands.Num();
+	}
+
+	/** Commands which are suspended */
+	UFUNCTION(BlueprintCallable, Category="MTasks")
+	int32 GetSuspendedDepth() const
+	{
+		return SuspendedCommands.Num();
+	}
+
+	/** Time every poll and keep totals per class, for mtasks.top and the overlay; off by default */
+	UFUNCTION(BlueprintCallable, Category="MTasks")
+	void SetClassProfiling(bool InProfileClasses);
+
+	bool IsClassProfiling() const
+	{
+		return ProfileClasses;
+	}
+
+	const TMap<TWeakObjectPtr<UClass>, FMTaskClassCost>& GetClassCosts() const
+	{
+		return ClassCosts;
+	}
+
+	void ResetClassCosts()
+	{
+		ClassCosts.Reset();
+	}
+
+	/** Heap held by the executor's own arrays and caches */
+	FMTaskExecutorMemory GetMemoryUsage() const;
+
+	/** Add the footprint of every live task and command to OutFootprints, by class; walks every entry */
+	void GetClassFootprints(TMap<UClass*, FMTaskClassFootprint>& OutFootprints) const;
+
+	/** Reported to memreport and obj list; the executor's own heap, not the tasks it manages */
+	virtual void GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize) override;
+
+	virtual void BeginDestroy() override;
+
+	/** Memoized world queries for tasks polled by this executor; reset at the start of every tick */
+	FMTaskQueryCache& GetQueryCache()
+	{
+		return QueryCache;
+	}
+
 	/**
 	 * Manage this task until it completes or fails.
 	 * Otherwise, this is an invalid operation.
@@ -168,12 +729,89 @@ public:
 	UFUNCTION(BlueprintCallable, Category="MTasks")
 	void CancelCommand(UMCommand* Command);
 
+	/**
+	 * Stop polling a running command, without ending it; it moves off the ready queues at the end of
+	 * the current or next tick. Cancelling it still works, and runs OnEnd as usual.
+	 */
+	UFUNCTION(BlueprintCallable, Category="MTasks")
+	void SuspendCommand(UMCommand* Command);
+
+	/** Poll a suspended command again; this renews its lease */
+	UFUNCTION(BlueprintCallable, Category="MTasks")
+	void ResumeCommand(UMCommand* Command);
+
+	/**
+	 * Cancel a task, every task chained from it with `Then`, and any command parented to them.
+	 * Descendants which have not started yet are rejected and will never run; they are still
+	 * notified on the next tick through their continuation and update delegates, but get no OnEnd.
+	 */
+	UFUNCTION(BlueprintCallable, Category="MTasks")
+	void CancelTree(UMTask* Task);
+
+	/** Cancel every task and command which was started with this context */
+	UFUNCTION(BlueprintCallable, Category="MTasks")
+	void CancelAllByContext(UObject* TaskContext);
+
+	/** Cancel the token, and immediately reject every task and command holding it */
+	UFUNCTION(BlueprintCallable, Category="MTasks")
+	void CancelAllByToken(UMCancellationToken* Token);
+
+	/**
+	 * Look for orphans, log a summary, and if Collect is set reject them; returns how many were found.
+	 *
+	 * - Commands with no listeners and no parent that have run longer than Policy.UnboundCommandTimeout.
+	 * - Commands whose parent has been destroyed; collecting clears the dangling Parent, which leaves
+	 *   them to the unbound command rule.
+	 *
+	 * Children on the branch their parent didn't take are not orphans, and are never reported. When
+	 * Policy.OrphanAction is Collect, they and their chain are rejected as the parent completes; their
+	 * continuation and update delegates fire on the next tick, but they get no OnEnd.
+	 */
+	UFUNCTION(BlueprintCallable, Category="MTasks")
+	int32 ScanForOrphans(bool Collect);
+
+	/** Cancel every task and command of this class or a subclass of it; returns how many were cancelled */
+	UFUNCTION(BlueprintCallable, Category="MTasks")
+	int32 CancelAllByClass(UClass* Class);
+
 private:
+	/** Mark every managed task and command matching the filters as rejected, in a single pass */
+	void CancelWhere(TFunctionRef<bool(const FMTaskExecutorManagedTask&)> TaskFilter,
+	                 TFunctionRef<bool(const FMTaskExecutorManagedCommand&)> CommandFilter);
+
+	/** Record the frame time, and rescale the budget, admission and low priority poll rate to match */
+	void UpdateAdaptivePolicy(float FrameTime);
+
+	/** Should an entry below AlwaysPollPriority sit this tick out to honour the adaptive stride? */
+	bool IsStrideSkipped(const FMTaskExecutorSchedule& Schedule) const;
+
+	/** Reject a task that will never run, and everything chained from it; they get no OnEnd */
+	void RejectOrphanTree(UMTask* Root);
+
+	/** Bring the memory stat up to date with this executor's current usage */
+	void UpdateMemoryStat();
+
+	/** Add one poll to the cost of an object's class */
+	void RecordClassCost(const UObject* Object, double Seconds) const;
+
+	/** Log a lifecycle call that exceeded the watchdog threshold */
+	void ReportSlowCall(const TCHAR* Event, const UObject* Object, const UObject* Context, double Seconds) const;
+
+	/** Count a slow poll against an entry, and apply the watchdog action to it and its State once it has too many */
+	template <typename T>
+	void ApplyWatchdog(T& Entry, UObject* Object, EMTaskState& State, double Seconds) const;
+
+	/** Move entries demoted this tick from the queue they were polled in to the Low queue */
+	void RequeueDemoted();
+
 	/** Apply execution policy rules like timeout after taking too long or whatever for tasks */
 	void ApplyExecutionPolicy(const FMTaskExecutorManagedTask& Task) const;
 
 	/** Apply execution policy rules like timeout after taking too long or whatever for commands */
-	void ApplyExecutionPolicy(const FMTaskExecutorManagedCommand& Cmd) const;
+	void ApplyExecutionPolicy(FMTaskExecutorManagedCommand& Cmd) const;
+
+	/** The command policy for a class; its closest entry in Policy.CommandPolicies, or Policy.CommandPolicy */
+	const FMTaskCommandPolicy& ResolveCommandPolicy(UClass* Class) const;
 
 	/**
 	 * Process a single tick on a task.
@@ -184,8 +822,24 @@ private:
 	/** Process a task which has fully resolved */
 	void ProcessCompletedTask(const FMTaskExecutorManagedTask& Task);
 
-	/** Process all tasks which are currently active */
-	void ProcessTasks(float DeltaTime);
+	/** Find, or compute and cache, the blueprint overrides for the class of this task or command */
+	template <typename T>
+	const FMTaskScriptOverrides& GetScriptOverrides(const T* Object) const;
+
+	/** Invoke OnStart natively when the class does not override it in blueprint */
+	template <typename T>
+	void DispatchOnStart(T* Object, UObject* Context) const;
+
+	/** Invoke OnPoll natively when the class does not override it in blueprint */
+	template <typename T>
+	EMTaskState DispatchOnPoll(T* Object, float DeltaTime) const;
+
+	/** Invoke OnEnd natively when the class does not override it in blueprint */
+	template <typename T>
+	void DispatchOnEnd(T* Object) const;
+
+	/** Process all tasks which are currently active at one priority level */
+	void ProcessTasks(FMTaskExecutorReadyQueue& Queue, float DeltaTime, bool IsBudgeted);
 
 	/**
 	 * Process a single tick on a command.
@@ -196,8 +850,35 @@ private:
 	/** Process a command which has fully resolved */
 	void ProcessCompletedCommand(const FMTaskExecutorManagedCommand& Cmd);
 	
-	/** Process all commands which are currently active */
-	void ProcessCommands(float DeltaTime);
+	/** Process all commands which are currently active at one priority level */
+	void ProcessCommands(FMTaskExecutorReadyQueue& Queue, float DeltaTime, bool IsBudgeted);
+
+	/** Move pending tasks and commands into the ready queue for their priority, starting them if required */
+	void AdmitPending();
+
+	/** Call OnStart on a managed task, or reject it unstarted if its cancellation token is already cancelled */
+	void StartManagedTask(FMTaskExecutorManagedTask& Task);
+
+	/** Call OnStart on a managed command, or reject it unstarted if its cancellation token is already cancelled */
+	void StartManagedCommand(FMTaskExecutorManagedCommand& Cmd);
+
+	/** Has this tick used up the policy TickBudget? */
+	bool IsOverBudget() const;
+
+	/** Current time on the budget clock */
+	double GetBudgetTime() const;
+
+	/** Pick a staggered first poll, so entries sharing an interval do not all poll on the same tick */
+	void StaggerSchedule(FMTaskExecutorSchedule& Schedule);
+
+	/** Delay the first poll of a newly admitted entry according to SpreadFirstPollTicks */
+	void SpreadFirstPoll(FMTaskExecutorSchedule& Schedule);
+
+	/** Has the poll interval of this entry elapsed? */
+	bool IsPollDue(const FMTaskExecutorSchedule& Schedule) const;
+
+	/** Move the schedule on to the next poll, keeping its phase where possible */
+	void AdvanceSchedule(FMTaskExecutorSchedule& Schedule) const;
 
 	/**
 	 * When a task is set to run, we actually need to run the first task in that chain.
@@ -7,10 +7,15 @@
 #include "MTask.generated.h"
 
 class UMTaskExecutor;
+class FMTaskQueryCache;
+class UMCancellationToken;
 
 class UMTask;
 DECLARE_MULTICAST_DELEGATE_OneParam(FTaskUpdate, UMTask*);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FTaskUpdateBP, UMTask*, Task);
+DECLARE_DELEGATE_OneParam(FTaskContinuation, UMTask*);
+DECLARE_MULTICAST_DELEGATE_TwoParams(FTaskProgress, UMTask*, float);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FTaskProgressBP, UMTask*, Task, float, Progress);
 
 UENUM(BlueprintType)
 enum class EMTaskState : uint8
@@ -31,6 +36,19 @@ enum class EMTaskState : uint8
 	Rejected,
 };
 
+UENUM(BlueprintType)
+enum class EMTaskPriority : uint8
+{
+	/** Cosmetic work; deferred first when the executor runs out of tick budget */
+	Low,
+
+	/** The default priority */
+	Normal,
+
+	/** Gameplay critical work; polled every tick regardless of budget by default */
+	High,
+};
+
 USTRUCT()
 struct MTASKS_API FMTaskChild
 {
@@ -85,9 +103,22 @@ struct MTASKS_API FMTaskChild
  * A task broadcasts its state update when it moves into Resolved or
  * Rejected using the OnUpdate delegate.
  *
+ * Native code that only needs a single listener should bind `Continuation`
+ * instead; it is invoked directly, without reflection, before any of the
+ * multicast delegates.
+ *
+ * A task may report how far along it is with `SetProgress`. Changes are
+ * coalesced and broadcast on `ProgressUpdate` and `OnProgress` by the executor
+ * after the task is polled, so listeners hear at most once per tick and only
+ * when the value actually changed.
+ *
  * If a task has a parent, it is passed to the OnStart and the implementation
  * must decide what to do with it.
  *
+ * The _Implementation methods of OnStart, OnPoll and OnEnd are declared so
+ * the executor can call them directly, skipping the reflection thunk, when a
+ * blueprint subclass does not override the event.
+ *
  * If a task has multiple children, they are executed in parallel, not in
  * sequence; but single in a single threaded context; ie. one call to OnPoll
  * per task per tick.
@@ -108,16 +139,53 @@ public:
 	
 	FTaskUpdate Update;
 
+	/** Single native listener invoked when the promise is updated; cheaper than Update or OnUpdate */
+	FTaskContinuation Continuation;
+
+	/** Invoked at most once per tick when Progress changes */
+	UPROPERTY(BlueprintAssignable, Category = "MTasks")
+	FTaskProgressBP OnProgress;
+
+	FTaskProgress ProgressUpdate;
+
 	/** The promise state */
 	UPROPERTY(BlueprintReadOnly, Category = "MTasks")
 	EMTaskState State;
 
+	/** How far along the task is, 0..1; set with SetProgress */
+	UPROPERTY(BlueprintReadOnly, Category = "MTasks")
+	float Progress = 0;
+
 	/** The parent of this task, if any */
 	UPROPERTY()
 	TWeakObjectPtr<UMTask> Parent = nullptr;
+
+	/** Polling priority; only read when the task is started */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "MTasks")
+	EMTaskPriority Priority = EMTaskPriority::Normal;
+
+	/** Poll at most once every N ticks; 0 polls every tick. Only read when the task is started */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "MTasks")
+	int PollIntervalTicks = 0;
+
+	/** Poll at most once every N seconds; 0 polls every tick. Only read when the task is started */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "MTasks")
+	float PollIntervalSeconds = 0;
+
+	/** The executor running this task; set when it is run */
+	UPROPERTY()
+	TWeakObjectPtr<UMTaskExecutor> OwningExecutor = nullptr;
+
+	/** Shared token which cancels this task; children inherit it when they start */
+	UPROPERTY(BlueprintReadWrite, Category = "MTasks")
+	UMCancellationToken* CancellationToken = nullptr;
 	
 	/** Children of this task */
 	TArray<FMTaskChild> Children;
+
+private:
+	/** Progress changed since it was last broadcast */
+	bool ProgressDirty = false;
 	
 public:
 	// Public API
@@ -134,6 +202,21 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "MTasks")
 	UMTask *Then(EMTaskState OnState, UMTask *Child);
 
+	/** Report progress, 0..1; listeners are notified after the task is next polled */
+	UFUNCTION(BlueprintCallable, Category = "MTasks")
+	void SetProgress(float InProgress);
+
+	/** Broadcast progress if it changed; the executor calls this once per poll */
+	void FlushProgress();
+
+	/** Per-tick world query cache of the executor running this task; null if it is not running */
+	FMTaskQueryCache* GetQueryCache() const;
+
+	/** Heap held by the invocation lists of this task's delegates */
+	SIZE_T GetDelegatesAllocatedSize() const;
+
+	virtual void GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize) override;
+
 	/** Is this task still un-started? ie. Idle or Waiting */
 	UFUNCTION(BlueprintCallable, Category = "MTasks")
 	FORCEINLINE bool IsPending()
@@ -164,14 +247,20 @@ public:
 	UFUNCTION(BlueprintNativeEvent, Category = "MTasks")
 	void OnStart(UObject *Context);
 
+	virtual void OnStart_Implementation(UObject *Context);
+
 	/**
 	 * Invoked when the command is completed; regardless of the state.
 	 * Use this to do a 'final' cleanup for things.
 	 **/
 	UFUNCTION(BlueprintNativeEvent, Category = "MTasks")
 	void OnEnd();
+
+	virtual void OnEnd_Implementation();
 	
 	/** Poll this task to update the state  */
 	UFUNCTION(BlueprintNativeEvent, Category = "MTasks")
 	EMTaskState OnPoll(float DeltaTime);
+
+	virtual EMTaskState OnPoll_Implementation(float DeltaTime);
 };
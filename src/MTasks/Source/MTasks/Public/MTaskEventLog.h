@@ -0,0 +1,133 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MTask.h"
+
+/** What happened to a task or command */
+enum class EMTaskEvent : uint8
+{
+	Queued,
+	Started,
+	Transition,
+	Completed,
+	Cancelled,
+
+	/** A child was run because its parent completed with the matching state; RelatedId is the parent */
+	Promoted,
+};
+
+/** A single entry in the event log; small and flat, so recording is a handful of stores */
+struct FMTaskEvent
+{
+	/** FPlatformTime::Cycles64 when the event was recorded */
+	uint64 Cycles = 0;
+
+	int64 Tick = 0;
+
+	/** UObject unique id; names are only resolved when the log is dumped or exported */
+	uint32 ObjectId = 0;
+
+	/** Unique id of the object's class, which usually outlives the object itself */
+	uint32 ClassId = 0;
+
+	/** Unique id of a related object, eg. the parent of a promoted child; 0 for none */
+	uint32 RelatedId = 0;
+
+	EMTaskEvent Kind = EMTaskEvent::Queued;
+	EMTaskState From = EMTaskState::Idle;
+	EMTaskState To = EMTaskState::Idle;
+	bool IsCommand = false;
+};
+
+/**
+ * Ring buffer of the last N task and command events.
+ * Cheap enough to leave on in production; dump or export it when something goes wrong.
+ *
+ * Record is lock-free and safe to call from several threads at once, eg. from a batch
+ * command's ParallelFor. Each slot carries a sequence number: a writer claims the slot by
+ * swapping it to Writing, so two writers whose tickets wrap onto the same slot can't
+ * interleave; the loser's event is dropped. Readers check the sequence before and after
+ * copying an event, and skip slots that changed. SetCapacity and Reset are game thread only.
+ */
+class MTASKS_API FMTaskEventLog
+{
+public:
+	/** Keep at least this many events, rounded up to a power of two; 0 disables recording */
+	void SetCapacity(int32 InCapacity);
+
+	FORCEINLINE void Record(EMTaskEvent Kind, const UObject* Object, EMTaskState From, EMTaskState To, int64 Tick, bool IsCommand,
+	                        const UObject* Related = nullptr)
+	{
+		if (Slots.Num() == 0) return;
+
+		const auto Ticket = FPlatformAtomics::InterlockedIncrement(&Head) - 1;
+		auto& Slot = Slots[Ticket & (Slots.Num() - 1)];
+
+		// Claim the slot; if another writer holds it, or already wrote a newer event, drop this one
+		const auto Previous = FPlatformAtomics::AtomicRead(&Slot.Sequence);
+		if (Previous == Writing || Previous > Ticket) return;
+		if (FPlatformAtomics::InterlockedCompareExchange(&Slot.Sequence, Writing, Previous) != Previous) return;
+
+		auto& Event = Slot.Event;
+		Event.Cycles = FPlatformTime::Cycles64();
+		Event.Tick = Tick;
+		Event.ObjectId = Object->GetUniqueID();
+		Event.ClassId = Object->GetClass()->GetUniqueID();
+		Event.RelatedId = Related ? Related->GetUniqueID() : 0;
+		Event.Kind = Kind;
+		Event.From = From;
+		Event.To = To;
+		Event.IsCommand = IsCommand;
+
+		FPlatformMisc::MemoryBarrier();
+		FPlatformAtomics::AtomicStore(&Slot.Sequence, Ticket + 1);
+	}
+
+	/** Visit the recorded events, oldest first */
+	void ForEach(TFunctionRef<void(const FMTaskEvent&)> Visitor) const;
+
+	/** Write the recorded events to an output device, oldest first */
+	void Dump(FOutputDevice& Out) const;
+
+	/**
+	 * The recorded events in the Chrome trace event format; load it in chrome://tracing or Perfetto.
+	 * Each task or command is a track, with a span from start to completion, instants for its state
+	 * changes and a flow arrow from each parent to the children it promoted.
+	 */
+	FString ToChromeTrace() const;
+
+	/** The recorded events as a CSV timeline, one row per event */
+	FString ToCsv() const;
+
+	void Reset();
+
+	SIZE_T GetAllocatedSize() const
+	{
+		return Slots.GetAllocatedSize();
+	}
+
+	int32 Num() const
+	{
+		return static_cast<int32>(FMath::Min<int64>(FPlatformAtomics::AtomicRead(&Head), Slots.Num()));
+	}
+
+private:
+	static constexpr int64 Writing = -1;
+
+	struct FSlot
+	{
+		FMTaskEvent Event;
+
+		/** Ticket + 1 of the event in this slot, 0 if empty, or Writing while a writer holds it */
+		volatile int64 Sequence = 0;
+	};
+
+	TArray<FSlot> Slots;
+
+	/** Total events ever recorded; the next ticket to hand out */
+	volatile int64 Head = 0;
+
+	int32 RequestedCapacity = 0;
+};
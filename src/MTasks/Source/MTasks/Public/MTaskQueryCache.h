@@ -0,0 +1,66 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineTypes.h"
+
+class AActor;
+class APlayerController;
+
+/**
+ * Per-tick memo of world queries many tasks ask the same question of.
+ *
+ * Owned by an executor and reset at the start of each of its ticks, so every task polled
+ * in that tick sees the same answer and N tasks asking cost one query. A task that changes
+ * the answer (eg. by possessing another pawn) should Invalidate the player it changed.
+ */
+class MTASKS_API FMTaskQueryCache
+{
+public:
+	/** The camera manager's view target for this player, if any */
+	AActor* GetViewTarget(APlayerController* PlayerController);
+
+	/** The player's view point */
+	void GetPlayerViewPoint(APlayerController* PlayerController, FVector& OutLocation, FRotator& OutRotation);
+
+	/** The hit under the cursor; this shares the pickers' async trace, so the result is a frame old */
+	bool GetHitResultUnderCursor(APlayerController* PlayerController, ETraceTypeQuery TraceType, bool bTraceComplex, FHitResult& OutHit);
+
+	/** Forget everything cached for one player */
+	void Invalidate(const APlayerController* PlayerController);
+
+	/** Forget everything; the executor calls this once per tick */
+	void Reset();
+
+	/** How many queries actually ran since the last reset */
+	int32 GetQueriesRun() const
+	{
+		return QueriesRun;
+	}
+
+	SIZE_T GetAllocatedSize() const
+	{
+		return ViewTargets.GetAllocatedSize() + ViewPoints.GetAllocatedSize() + CursorHits.GetAllocatedSize();
+	}
+
+private:
+	struct FViewPoint
+	{
+		FVector Location;
+		FRotator Rotation;
+	};
+
+	struct FCursorHit
+	{
+		bool DidHit;
+		FHitResult Hit;
+	};
+
+	// Reset every tick, so raw keys can't outlive their players; cursor hits are keyed on channel and complexity
+	TMap<const APlayerController*, TWeakObjectPtr<AActor>> ViewTargets;
+	TMap<const APlayerController*, FViewPoint> ViewPoints;
+	TMap<TPair<const APlayerController*, int32>, FCursorHit> CursorHits;
+
+	int32 QueriesRun = 0;
+};
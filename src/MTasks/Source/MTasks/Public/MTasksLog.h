@@ -0,0 +1,29 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+MTASKS_API DECLARE_LOG_CATEGORY_EXTERN(LogMTasks, Log, All);
+
+/** Executor tracing is compiled out of shipping builds unless this is set explicitly */
+#ifndef MTASKS_TRACE_ENABLED
+#define MTASKS_TRACE_ENABLED !UE_BUILD_SHIPPING
+#endif
+
+/**
+ * Trace executor activity when Condition holds; usually the executor's VerboseLogging flag.
+ * Arguments are only evaluated when tracing, so they can be as expensive as they like.
+ */
+#if MTASKS_TRACE_ENABLED
+#define MTASKS_TRACE(Condition, Format, ...) \
+	do \
+	{ \
+		if (UNLIKELY(Condition)) \
+		{ \
+			UE_LOG(LogMTasks, Display, Format, ##__VA_ARGS__); \
+		} \
+	} while (0)
+#else
+#define MTASKS_TRACE(Condition, Format, ...) do {} while (0)
+#endif
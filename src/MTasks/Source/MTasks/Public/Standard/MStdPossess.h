@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "MTask.h"
 #include "Camera/CameraComponent.h"
+#include "Standard/Tween/MStdTweenSubsystem.h"
 #include "UObject/Object.h"
 #include "MStdPossess.generated.h"
 
@@ -13,6 +14,9 @@
  * - lock the player input
  * - tween the camera to the camera location of the target
  * - possess the target
+ *
+ * The camera tween is advanced by the executor's DeltaTime, not the world tick, so it
+ * pauses and scales with the executor running this task.
  */
 UCLASS(BlueprintType)
 class MTASKS_API UMStdPossess : public UMTask
@@ -35,6 +39,9 @@ public:
 	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="MTasks|Standard")
 	bool LockPlayerInput;
 
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="MTasks|Standard")
+	EMStdEase Ease = EMStdEase::Linear;
+
 	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="MTasks|Standard")
 	APlayerController* PlayerController;
 
@@ -44,10 +51,7 @@ public:
 private:
 	// Internal state
 	bool Validated;
-	FVector OriginalPosition;
-	FVector TargetPosition;
-	TWeakObjectPtr<UCameraComponent> NewCamera;
-	float Elapsed;
+	FMStdTweenHandle CameraTween;
 
 	StdPossessState InternalState;
 
@@ -66,6 +70,9 @@ public:
 
 	virtual void OnStart_Implementation(UObject* Context) override;
 
+	virtual void OnEnd_Implementation() override;
+
 private:
-	void StepCamera(float Amount);
+	/** Hand the camera move to the tween subsystem; the tween runs from the old view to the new camera */
+	bool StartCameraTween(UCameraComponent* OriginalCamera, UCameraComponent* NewCamera);
 };
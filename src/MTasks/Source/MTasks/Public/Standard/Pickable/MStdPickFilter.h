@@ -0,0 +1,44 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+
+/**
+ * Tracks which actor a picker is focused on, doing as little blueprint work as possible:
+ * - the type and IMStdPickable checks are cached per class.
+ * - CanBeSelected is only asked when the actor under the cursor changes.
+ * - OnHighlight(true) / OnHighlight(false) are only sent when the focus changes.
+ */
+struct MTASKS_API FMStdPickFilter
+{
+public:
+	/**
+	 * Update the focus from the actor currently under the cursor, if any.
+	 * Returns the focused actor, or null if HitActor cannot be picked.
+	 */
+	AActor* Update(AActor* HitActor, TSubclassOf<AActor> PickActorType, UObject* Picker);
+
+	/** Drop the focus, sending OnHighlight(false) if an actor was highlighted */
+	void Clear();
+
+	/** The currently focused actor, if any */
+	AActor* GetFocus() const
+	{
+		return Focused.Get();
+	}
+
+private:
+	/** Is this class a pickable subclass of PickActorType? */
+	bool IsPickableClass(UClass* Class, TSubclassOf<AActor> PickActorType);
+
+	/** Move the focus, sending highlight transitions */
+	void SetFocus(AActor* Actor);
+
+	TMap<TWeakObjectPtr<UClass>, bool> PickableClasses;
+
+	TWeakObjectPtr<AActor> LastHitActor;
+
+	TWeakObjectPtr<AActor> Focused;
+};
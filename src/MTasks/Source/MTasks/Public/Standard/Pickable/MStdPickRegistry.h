@@ -0,0 +1,88 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/SceneComponent.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "MStdPickRegistry.generated.h"
+
+/** A pickable actor stored in a cell of the registry */
+struct FMStdPickRegistryItem
+{
+	TWeakObjectPtr<AActor> Actor;
+	FVector Location;
+};
+
+/** Bookkeeping for a registered pickable actor */
+struct FMStdPickRegistryEntry
+{
+	FIntVector Cell;
+	TWeakObjectPtr<USceneComponent> Root;
+	FDelegateHandle MovedHandle;
+};
+
+/**
+ * Spatial hash of the IMStdPickable actors in a world, for picking without a cursor.
+ *
+ * Pickables register themselves (eg. from BeginPlay) and are then kept up to date
+ * incrementally as their root component moves. Queries only visit the cells which
+ * overlap the query, so finding the nearest pickable in a cone is cheap even with
+ * many thousands of registered actors.
+ */
+UCLASS()
+class MTASKS_API UMStdPickRegistry : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** Size of a spatial hash cell, in world units */
+	static constexpr float CellSize = 1000.0f;
+
+private:
+	TMap<FIntVector, TArray<FMStdPickRegistryItem>> Cells;
+
+	TMap<TWeakObjectPtr<AActor>, FMStdPickRegistryEntry> Entries;
+
+public:
+	/** Find the registry for a world */
+	static UMStdPickRegistry* Get(const UObject* WorldContextObject);
+
+	/** Add an actor to the registry of its world; call this from BeginPlay */
+	UFUNCTION(BlueprintCallable, Category="MTasks|Standard|Pickable", meta=(DefaultToSelf="Actor"))
+	static void RegisterPickable(AActor* Actor);
+
+	/** Remove an actor from the registry of its world; destroyed actors are removed automatically */
+	UFUNCTION(BlueprintCallable, Category="MTasks|Standard|Pickable", meta=(DefaultToSelf="Actor"))
+	static void UnregisterPickable(AActor* Actor);
+
+	/**
+	 * Find the nearest registered actor of the given type inside a cone.
+	 * Returns null if there is none.
+	 */
+	AActor* FindNearestInCone(const FVector& Origin, const FVector& Direction, float MaxDistance, float HalfAngleDegrees,
+	                          TSubclassOf<AActor> PickActorType) const;
+
+	/** Number of registered actors */
+	int32 Num() const
+	{
+		return Entries.Num();
+	}
+
+	virtual void Deinitialize() override;
+
+private:
+	void Add(AActor* Actor);
+
+	void Remove(AActor* Actor);
+
+	/** Move an actor between cells, or just update its location */
+	void Move(AActor* Actor, const FVector& Location);
+
+	void OnPickableMoved(USceneComponent* Component, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport);
+
+	UFUNCTION()
+	void OnPickableDestroyed(AActor* Actor);
+
+	static FIntVector ToCell(const FVector& Location);
+};
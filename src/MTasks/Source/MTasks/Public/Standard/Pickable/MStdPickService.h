@@ -0,0 +1,176 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineTypes.h"
+#include "MStdPickFilter.h"
+#include "MStdPickTrace.h"
+#include "Subsystems/LocalPlayerSubsystem.h"
+#include "MStdPickService.generated.h"
+
+class UInputComponent;
+class FMTaskQueryCache;
+
+UENUM(BlueprintType, Category="MTasks|Standard|Pickable")
+enum class EMStdPickerMode : uint8
+{
+	/** Pick whatever is under the mouse cursor */
+	Cursor,
+
+	/** Pick the nearest registered pickable in a cone from the player view point; see UMStdPickRegistry */
+	Gamepad,
+};
+
+/** What a picker task asks of the pick service */
+struct MTASKS_API FMStdPickRequest
+{
+	EMStdPickerMode Mode = EMStdPickerMode::Cursor;
+	ETraceTypeQuery TraceType = TraceTypeQuery1;
+	TSubclassOf<AActor> PickActorType;
+	float MaxDistance = 0;
+	float HalfAngleDegrees = 0;
+	FName SelectAction;
+	FName CancelAction;
+
+	/** Can two requests share the same pick resolution? Input actions do not matter */
+	bool IsSameQuery(const FMStdPickRequest& Other) const
+	{
+		return Mode == Other.Mode && TraceType == Other.TraceType && PickActorType == Other.PickActorType &&
+			MaxDistance == Other.MaxDistance && HalfAngleDegrees == Other.HalfAngleDegrees;
+	}
+};
+
+/** The pick resolved for one frame */
+struct MTASKS_API FMStdPickResult
+{
+	bool DidHit = false;
+	TWeakObjectPtr<AActor> Focus;
+	FVector Location = FVector::ZeroVector;
+	FVector Normal = FVector::ZeroVector;
+};
+
+/** Implemented by picker tasks to receive input from the pick service */
+class MTASKS_API FMStdPickServiceClient
+{
+public:
+	virtual ~FMStdPickServiceClient() = default;
+
+	virtual void OnPickSelectPressed() = 0;
+
+	virtual void OnPickSelectReleased() = 0;
+
+	virtual void OnPickCancelPressed() = 0;
+};
+
+/** A picker in a group; CanBeSelected depends on the picker, so each one filters the shared hit itself */
+struct FMStdPickServiceMember
+{
+	TWeakObjectPtr<UObject> Picker;
+	FMStdPickFilter Filter;
+};
+
+/** Pickers which share the same query, and the single trace they share each frame */
+struct FMStdPickServiceGroup
+{
+	FMStdPickRequest Query;
+	TArray<FMStdPickServiceMember> Members;
+	uint64 LastFrame = 0;
+
+	/** The shared hit of this frame; Result.Focus is unused, focus is resolved per member */
+	FMStdPickResult Result;
+	TWeakObjectPtr<AActor> Hit;
+};
+
+/** A registered picker */
+struct FMStdPickServiceClientEntry
+{
+	TWeakObjectPtr<UObject> Object;
+	FMStdPickServiceClient* Client = nullptr;
+	FName SelectAction;
+	FName CancelAction;
+};
+
+/** The input bindings for one action, shared by every picker using it */
+struct FMStdPickServiceAction
+{
+	int32 RefCount = 0;
+	int32 PressedHandle = INDEX_NONE;
+	int32 ReleasedHandle = INDEX_NONE;
+};
+
+/**
+ * One pick service per local player, shared by every active picker task of that player.
+ *
+ * The service owns the input bindings, so starting and ending a picker never touches the
+ * input component unless it uses a new action. Pickers with the same query share one
+ * trace (or registry query) per frame, done by whichever of them is polled first; each
+ * picker then filters the hit with its own CanBeSelected and highlight state.
+ */
+UCLASS()
+class MTASKS_API UMStdPickService : public ULocalPlayerSubsystem
+{
+	GENERATED_BODY()
+
+private:
+	TWeakObjectPtr<APlayerController> PlayerController;
+
+	TWeakObjectPtr<UInputComponent> BoundInputComponent;
+
+	TArray<FMStdPickServiceGroup> Groups;
+
+	TArray<FMStdPickServiceClientEntry> Clients;
+
+	TMap<FName, FMStdPickServiceAction> Actions;
+
+	/** Shared cursor trace per channel and trace complexity; see FMStdPickTrace */
+	TMap<uint32, FMStdPickTraceState> Traces;
+
+public:
+	/** Find the pick service for a player; null if the controller has no local player */
+	static UMStdPickService* Get(const APlayerController* InPlayerController);
+
+	/** Start dispatching input and pick results to a picker */
+	void AddPicker(UObject* Picker, FMStdPickServiceClient* Client, APlayerController* InPlayerController, const FMStdPickRequest& Request);
+
+	/** Stop dispatching to a picker; safe to call more than once */
+	void RemovePicker(UObject* Picker);
+
+	/** The pick for this frame, for a registered picker */
+	FMStdPickResult Resolve(UObject* Picker);
+
+	/** The cursor trace state for a channel, created on first use */
+	FMStdPickTraceState& GetTraceState(ETraceTypeQuery TraceType, bool bTraceComplex);
+
+	/** Number of distinct queries; pickers with the same query share one */
+	int32 NumQueries() const
+	{
+		return Groups.Num();
+	}
+
+	virtual void Deinitialize() override;
+
+private:
+	/** Trace, or query the registry, for a group; view points and cursor hits go through Queries when the picker has one */
+	void ResolveGroup(FMStdPickServiceGroup& Group, FMTaskQueryCache* Queries);
+
+	void RetainAction(FName Action);
+
+	void ReleaseAction(FName Action);
+
+	/** Bind an action on the current input component */
+	void BindAction(FName Action, FMStdPickServiceAction& Binding);
+
+	/** Unbind an action from the input component it was bound on */
+	void UnbindAction(FMStdPickServiceAction& Binding);
+
+	/** If the controller has a new input component, move every binding to it */
+	void RefreshInputComponent();
+
+	void OnActionPressed(FName Action);
+
+	void OnActionReleased(FName Action);
+
+	/** Is a picker taken from a copy of Clients still registered? */
+	bool IsStillRegistered(const FMStdPickServiceClientEntry& Target) const;
+};
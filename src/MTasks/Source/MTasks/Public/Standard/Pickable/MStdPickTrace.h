@@ -0,0 +1,45 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineTypes.h"
+#include "WorldCollision.h"
+
+class APlayerController;
+
+/** The shared cursor trace of one local player on one channel; owned by that player's UMStdPickService */
+struct MTASKS_API FMStdPickTraceState
+{
+	/** The controller and world the pending trace was issued for; the state starts over if either changes */
+	TWeakObjectPtr<APlayerController> PlayerController;
+	TWeakObjectPtr<UWorld> World;
+
+	uint64 LastFrame = 0;
+	FTraceHandle Handle;
+	bool HasHit = false;
+	FHitResult Hit;
+};
+
+/**
+ * Shared asynchronous cursor trace for the picker tasks.
+ *
+ * The first picker to ask in a frame consumes the async trace issued on the previous
+ * frame and issues the next one; every other picker using the same controller and
+ * channel that frame reads the same result. That is one deprojection and one trace
+ * per controller per frame, none of which blocks the game thread.
+ *
+ * The cost is that results are always one frame old.
+ *
+ * The trace state lives in the UMStdPickService of the controller's local player, so it goes
+ * away with that player rather than outliving the world or the PIE session.
+ */
+class MTASKS_API FMStdPickTrace
+{
+public:
+	/**
+	 * Like APlayerController::GetHitResultUnderCursorByChannel, but returns the result
+	 * of the trace issued on the previous frame.
+	 */
+	static bool GetHitResultUnderCursor(APlayerController* PlayerController, ETraceTypeQuery TraceType, bool bTraceComplex, FHitResult& OutResult);
+};
@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "GameplayTagContainer.h"
 #include "MStdPickable.h"
+#include "MStdPickService.h"
 #include "MTask.h"
 #include "UObject/Object.h"
 #include "MStdPicker.generated.h"
@@ -22,8 +23,12 @@ enum class EMStdPickerState : uint8
 	PickStarted,
 };
 
+/**
+ * Pick an in-world actor. Input and tracing are provided by the UMStdPickService of
+ * the player, which the picker is registered with while it is running.
+ */
 UCLASS(BlueprintType)
-class MTASKS_API UMStdPicker : public UMTask
+class MTASKS_API UMStdPicker : public UMTask, public FMStdPickServiceClient
 {
 	GENERATED_BODY()
 
@@ -40,6 +45,17 @@ public:
 	UPROPERTY()
 	EMStdPickerState PickerState = EMStdPickerState::Idle;
 
+	UPROPERTY()
+	EMStdPickerMode Mode = EMStdPickerMode::Cursor;
+
+	/** Gamepad mode; how far from the view point to look for pickables */
+	UPROPERTY()
+	float GamepadMaxDistance;
+
+	/** Gamepad mode; half angle in degrees of the cone to look for pickables in */
+	UPROPERTY()
+	float GamepadHalfAngle;
+
 	UPROPERTY()
 	APlayerController* PlayerController = nullptr;
 
@@ -51,9 +67,11 @@ public:
 
 	ETraceTypeQuery TraceType;
 
-	FInputActionBinding OnSelectBinding;
+	UPROPERTY()
+	FName SelectAction;
 
-	FInputActionBinding OnCancelBinding;
+	UPROPERTY()
+	FName CancelAction;
 
 	UPROPERTY()
 	TSubclassOf<AActor> PickActorType;
@@ -69,20 +87,38 @@ public:
 	                              float InTimeout,
 	                              TSubclassOf<AActor> InPickActorOfType);
 
+	/** Create a picker task to select the nearest in-world object in front of the player, without a cursor */
+	UFUNCTION(BlueprintCallable, Category="MTasks|Standard|Pickable", meta = (WorldContext = "WorldContextObject"))
+	static UMStdPicker* StdPickerGamepad(UObject* WorldContextObject,
+	                                     APlayerController* InPlayerController,
+	                                     FName SelectAction,
+	                                     FName CancelAction,
+	                                     float InTimeout,
+	                                     TSubclassOf<AActor> InPickActorOfType,
+	                                     float InMaxDistance,
+	                                     float InHalfAngleDegrees);
+
 public:
+	virtual void OnStart_Implementation(UObject* Context) override;
+
 	virtual EMTaskState OnPoll_Implementation(float DeltaTime) override;
 
-private:
-	void OnSelectPressed();
+	virtual void OnEnd_Implementation() override;
 
-	void OnCancelPressed();
+	virtual void OnPickSelectPressed() override;
 
-	void ClearBindings() const;
+	virtual void OnPickSelectReleased() override;
+
+	virtual void OnPickCancelPressed() override;
+
+private:
+	/** Stop receiving input and pick results from the pick service */
+	void UnregisterPicker();
 
 	/** Picked an actual actor */
 	void PickCurrent();
 
-	/** Lock for something to focus on */
+	/** Look for something to focus on */
 	void ScanForWorldActor();
 
 	/** Failed to pick anything */
@@ -11,9 +11,15 @@
  * Like standard picker but with an incremental picker mode.
  * ie. OnPicked is only invoked after 5 seconds spent 'picking'.
  * Use this, for example, for crafting or gathering, or any action-over-time.
+ *
+ * States:
+ * - Seeking: ask the pick service what is under the cursor every poll.
+ * - PickStarted: select is held on a target; no traces, the target is only re-checked
+ *   every RevalidateInterval seconds, and dropped immediately if it is destroyed.
+ * - Picked / PickCancelled: resolve or reject on the next poll.
  */
 UCLASS(BlueprintType)
-class MTASKS_API UMStdPickerTimed : public UMTask
+class MTASKS_API UMStdPickerTimed : public UMTask, public FMStdPickServiceClient
 {
 	GENERATED_BODY()
 
@@ -30,12 +36,12 @@ public:
 	AActor* PickedActor;
 
 public:
-	FInputActionBinding OnSelectPressedBinding;
+	UPROPERTY()
+	FName SelectAction;
+
+	UPROPERTY()
+	FName CancelAction;
 
-	FInputActionBinding OnSelectReleasedBinding;
-	
-	FInputActionBinding OnCancelBinding;
-	
 	UPROPERTY()
 	float PickAfterTime;
 
@@ -48,6 +54,10 @@ public:
 	UPROPERTY()
 	float Timeout;
 
+	/** While picking, how often to check the target is still under the cursor */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="MTasks|Standard|Pickable")
+	float RevalidateInterval = 0.25f;
+
 	UPROPERTY()
 	EMStdPickerState PickerState = EMStdPickerState::Idle;
 
@@ -72,19 +82,37 @@ public:
 	                                        TSubclassOf<AActor> InPickActorOfType);
 
 public:
+	virtual void OnStart_Implementation(UObject* Context) override;
+
 	virtual EMTaskState OnPoll_Implementation(float DeltaTime) override;
 
-private:
-	/** Move back to the seeking state */
-	void OnSelectReleased();
+	virtual void OnEnd_Implementation() override;
 
 	/** Start picking this actor */
-	void OnSelectPressed();
+	virtual void OnPickSelectPressed() override;
+
+	/** Move back to the seeking state */
+	virtual void OnPickSelectReleased() override;
 
 	/** Abort any attempt to select and reject this task */
-	void OnCancelPressed();
+	virtual void OnPickCancelPressed() override;
+
+private:
+	/** Time since the target was last re-checked while picking */
+	float SinceRevalidate = 0;
+
+	EMTaskState PollSeeking(float DeltaTime);
 
-	void ClearBindings() const;
+	EMTaskState PollPickStarted(float DeltaTime);
+
+	/** Is the target still pickable and still the focus? Traces, so only called on the revalidate cadence */
+	bool RevalidateTarget();
+
+	/** Drop back to seeking and reset any time spent picking */
+	void ResetPick();
+
+	/** Stop receiving input and pick results from the pick service */
+	void UnregisterPicker();
 
 	/** Picked an actual actor */
 	void PickCurrent();
@@ -94,5 +122,4 @@ private:
 
 	/** Failed to pick anything */
 	void AbortPick();
-
 };
@@ -0,0 +1,164 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MTask.h"
+#include "Standard/Tween/MStdTweenSubsystem.h"
+#include "MStdTween.generated.h"
+
+/**
+ * Base for tasks that tween a value over time.
+ *
+ * The value is written by the tween subsystem, which evaluates every active tween of a type
+ * together; the task only starts the tween and resolves once the subsystem has finished it.
+ * The task is rejected if the target goes away before the tween completes.
+ *
+ * Target is either an object with a property named PropertyName, or, if PropertyName is
+ * None, a scene component whose relative location, rotation or transform is tweened.
+ */
+UCLASS(Abstract, BlueprintType)
+class MTASKS_API UMStdTween : public UMTask
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="MTasks|Standard|Tween")
+	UObject* Target;
+
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="MTasks|Standard|Tween")
+	FName PropertyName;
+
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="MTasks|Standard|Tween")
+	float OverSeconds;
+
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="MTasks|Standard|Tween")
+	EMStdEase Ease = EMStdEase::Linear;
+
+	/** If set, used instead of Ease; sampled over 0..1 */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="MTasks|Standard|Tween")
+	UCurveFloat* Curve;
+
+protected:
+	FMStdTweenHandle Handle;
+
+public:
+	virtual void OnStart_Implementation(UObject* Context) override;
+
+	virtual EMTaskState OnPoll_Implementation(float DeltaTime) override;
+
+	virtual void OnEnd_Implementation() override;
+
+protected:
+	/** Start the typed tween on the subsystem */
+	virtual FMStdTweenHandle StartTween(UMStdTweenSubsystem* Tweens, const FMStdTweenBinding& Binding, const FMStdTweenTiming& Timing)
+	PURE_VIRTUAL(UMStdTween::StartTween, return FMStdTweenHandle(););
+
+	/** Shared setup for the typed factories */
+	void InitTween(UObject* InTarget, FName InPropertyName, float InOverSeconds, EMStdEase InEase, UCurveFloat* InCurve);
+};
+
+UCLASS(BlueprintType)
+class MTASKS_API UMStdTweenFloat : public UMStdTween
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="MTasks|Standard|Tween")
+	float From;
+
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="MTasks|Standard|Tween")
+	float To;
+
+	/** Tween a float property */
+	UFUNCTION(BlueprintCallable, Category="MTasks|Standard|Tween", meta=(WorldContext="WorldContextObject"))
+	static UMStdTweenFloat* StdTweenFloat(UObject* WorldContextObject, UObject* InTarget, FName InPropertyName, float InFrom, float InTo,
+	                                      float InOverSeconds, EMStdEase InEase, UCurveFloat* InCurve);
+
+protected:
+	virtual FMStdTweenHandle StartTween(UMStdTweenSubsystem* Tweens, const FMStdTweenBinding& Binding, const FMStdTweenTiming& Timing) override;
+};
+
+UCLASS(BlueprintType)
+class MTASKS_API UMStdTweenVector : public UMStdTween
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="MTasks|Standard|Tween")
+	FVector From;
+
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="MTasks|Standard|Tween")
+	FVector To;
+
+	/** Tween a vector property, or a scene component's relative location */
+	UFUNCTION(BlueprintCallable, Category="MTasks|Standard|Tween", meta=(WorldContext="WorldContextObject"))
+	static UMStdTweenVector* StdTweenVector(UObject* WorldContextObject, UObject* InTarget, FName InPropertyName, FVector InFrom, FVector InTo,
+	                                        float InOverSeconds, EMStdEase InEase, UCurveFloat* InCurve);
+
+protected:
+	virtual FMStdTweenHandle StartTween(UMStdTweenSubsystem* Tweens, const FMStdTweenBinding& Binding, const FMStdTweenTiming& Timing) override;
+};
+
+UCLASS(BlueprintType)
+class MTASKS_API UMStdTweenRotator : public UMStdTween
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="MTasks|Standard|Tween")
+	FRotator From;
+
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="MTasks|Standard|Tween")
+	FRotator To;
+
+	/** Tween a rotator property, or a scene component's relative rotation, along the shortest path */
+	UFUNCTION(BlueprintCallable, Category="MTasks|Standard|Tween", meta=(WorldContext="WorldContextObject"))
+	static UMStdTweenRotator* StdTweenRotator(UObject* WorldContextObject, UObject* InTarget, FName InPropertyName, FRotator InFrom, FRotator InTo,
+	                                          float InOverSeconds, EMStdEase InEase, UCurveFloat* InCurve);
+
+protected:
+	virtual FMStdTweenHandle StartTween(UMStdTweenSubsystem* Tweens, const FMStdTweenBinding& Binding, const FMStdTweenTiming& Timing) override;
+};
+
+UCLASS(BlueprintType)
+class MTASKS_API UMStdTweenColor : public UMStdTween
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="MTasks|Standard|Tween")
+	FLinearColor From;
+
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="MTasks|Standard|Tween")
+	FLinearColor To;
+
+	/** Tween a linear color property */
+	UFUNCTION(BlueprintCallable, Category="MTasks|Standard|Tween", meta=(WorldContext="WorldContextObject"))
+	static UMStdTweenColor* StdTweenColor(UObject* WorldContextObject, UObject* InTarget, FName InPropertyName, FLinearColor InFrom, FLinearColor InTo,
+	                                      float InOverSeconds, EMStdEase InEase, UCurveFloat* InCurve);
+
+protected:
+	virtual FMStdTweenHandle StartTween(UMStdTweenSubsystem* Tweens, const FMStdTweenBinding& Binding, const FMStdTweenTiming& Timing) override;
+};
+
+UCLASS(BlueprintType)
+class MTASKS_API UMStdTweenTransform : public UMStdTween
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="MTasks|Standard|Tween")
+	FTransform From;
+
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="MTasks|Standard|Tween")
+	FTransform To;
+
+	/** Tween a transform property, or a scene component's relative transform */
+	UFUNCTION(BlueprintCallable, Category="MTasks|Standard|Tween", meta=(WorldContext="WorldContextObject"))
+	static UMStdTweenTransform* StdTweenTransform(UObject* WorldContextObject, UObject* InTarget, FName InPropertyName, FTransform InFrom, FTransform InTo,
+	                                              float InOverSeconds, EMStdEase InEase, UCurveFloat* InCurve);
+
+protected:
+	virtual FMStdTweenHandle StartTween(UMStdTweenSubsystem* Tweens, const FMStdTweenBinding& Binding, const FMStdTweenTiming& Timing) override;
+};
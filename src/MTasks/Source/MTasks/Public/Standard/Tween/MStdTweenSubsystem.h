@@ -0,0 +1,290 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Tickable.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "MStdTweenSubsystem.generated.h"
+
+class UCurveFloat;
+class USceneComponent;
+
+UENUM(BlueprintType, Category="MTasks|Standard|Tween")
+enum class EMStdEase : uint8
+{
+	Linear,
+	EaseIn,
+	EaseOut,
+	EaseInOut,
+};
+
+/** Refers to a running tween */
+USTRUCT(BlueprintType)
+struct MTASKS_API FMStdTweenHandle
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	int32 Id = 0;
+
+	bool IsValid() const
+	{
+		return Id != 0;
+	}
+};
+
+/**
+ * Tween the relative transform and field of view of a scene component.
+ * Each track is optional; FieldOfView only applies to camera components.
+ */
+USTRUCT(BlueprintType)
+struct MTASKS_API FMStdTransformTween
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="MTasks|Standard|Tween")
+	USceneComponent* Target = nullptr;
+
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="MTasks|Standard|Tween")
+	float Duration = 0;
+
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="MTasks|Standard|Tween")
+	EMStdEase Ease = EMStdEase::Linear;
+
+	/** If set, used instead of Ease; sampled over 0..1 */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="MTasks|Standard|Tween")
+	UCurveFloat* Curve = nullptr;
+
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="MTasks|Standard|Tween")
+	bool TweenLocation = false;
+
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="MTasks|Standard|Tween")
+	FVector FromLocation = FVector::ZeroVector;
+
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="MTasks|Standard|Tween")
+	FVector ToLocation = FVector::ZeroVector;
+
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="MTasks|Standard|Tween")
+	bool TweenRotation = false;
+
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="MTasks|Standard|Tween")
+	FRotator FromRotation = FRotator::ZeroRotator;
+
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="MTasks|Standard|Tween")
+	FRotator ToRotation = FRotator::ZeroRotator;
+
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="MTasks|Standard|Tween")
+	bool TweenFieldOfView = false;
+
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="MTasks|Standard|Tween")
+	float FromFieldOfView = 90;
+
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="MTasks|Standard|Tween")
+	float ToFieldOfView = 90;
+
+	/** Skip this tween on the world tick; its owner drives it with AdvanceTween, eg. to follow executor time */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="MTasks|Standard|Tween")
+	bool AdvancedByOwner = false;
+};
+
+/** Where a value tween writes its output; a reflected property, or a scene component's relative transform */
+struct MTASKS_API FMStdTweenBinding
+{
+	TWeakObjectPtr<UObject> Object;
+
+	/** If null, the value is applied to Object as a scene component */
+	FProperty* Property = nullptr;
+
+	/**
+	 * Set<PropertyName>, if Object has one taking just the value; eg. ULightComponent::SetIntensity.
+	 * Setters update render state and anything derived from the property, so values are written through them.
+	 */
+	UFunction* Setter = nullptr;
+
+	/** Bind to a named property on Object; if PropertyName is None the object itself is the target */
+	static FMStdTweenBinding ForProperty(UObject* Object, FName PropertyName);
+};
+
+/** How a value tween progresses over time */
+struct MTASKS_API FMStdTweenTiming
+{
+	float Duration = 0;
+	EMStdEase Ease = EMStdEase::Linear;
+	UCurveFloat* Curve = nullptr;
+};
+
+/**
+ * Packed storage for every active tween of one value type.
+ * Slots are parallel arrays so the evaluation kernel walks contiguous memory; removal swaps
+ * the last slot into the hole, so slot indices are only stable within a tick.
+ */
+template <typename TValue>
+struct TMStdTweenChannel
+{
+	TArray<int32> Ids;
+	TArray<float> Elapsed;
+	TArray<float> Durations;
+	TArray<float> Alphas;
+	TArray<EMStdEase> Eases;
+	TArray<TWeakObjectPtr<UCurveFloat>> Curves;
+	TArray<FMStdTweenBinding> Bindings;
+	TArray<TValue> From;
+	TArray<TValue> To;
+	TArray<TValue> Values;
+
+	/** Slot index by tween id */
+	TMap<int32, int32> IndexById;
+
+	int32 Num() const
+	{
+		return Ids.Num();
+	}
+
+	void Add(int32 Id, const FMStdTweenBinding& Binding, const FMStdTweenTiming& Timing, const TValue& InFrom, const TValue& InTo)
+	{
+		IndexById.Add(Id, Ids.Add(Id));
+		Elapsed.Add(0);
+		Durations.Add(FMath::Max(Timing.Duration, 0.0f));
+		Alphas.Add(0);
+		Eases.Add(Timing.Ease);
+		Curves.Add(Timing.Curve);
+		Bindings.Add(Binding);
+		From.Add(InFrom);
+		To.Add(InTo);
+		Values.Add(InFrom);
+	}
+
+	void RemoveAtSwap(int32 Index)
+	{
+		IndexById.Remove(Ids[Index]);
+		Ids.RemoveAtSwap(Index, 1, false);
+		Elapsed.RemoveAtSwap(Index, 1, false);
+		Durations.RemoveAtSwap(Index, 1, false);
+		Alphas.RemoveAtSwap(Index, 1, false);
+		Eases.RemoveAtSwap(Index, 1, false);
+		Curves.RemoveAtSwap(Index, 1, false);
+		Bindings.RemoveAtSwap(Index, 1, false);
+		From.RemoveAtSwap(Index, 1, false);
+		To.RemoveAtSwap(Index, 1, false);
+		Values.RemoveAtSwap(Index, 1, false);
+		if (Index < Ids.Num())
+		{
+			IndexById.Add(Ids[Index], Index);
+		}
+	}
+};
+
+/** Transform channel value; translation and scale are widened to four lanes for the kernel */
+struct FMStdTweenTransformValue
+{
+	FVector4 Translation;
+	FQuat Rotation;
+	FVector4 Scale;
+};
+
+/**
+ * A running transform tween.
+ * This is not reflected, so the object references of Tween are held weakly here and cleared in the copy.
+ */
+struct FMStdTransformTweenState
+{
+	int32 Id = 0;
+	float Elapsed = 0;
+	TWeakObjectPtr<USceneComponent> Target;
+	TWeakObjectPtr<UCurveFloat> Curve;
+	FMStdTransformTween Tween;
+	FQuat FromQuat = FQuat::Identity;
+	FQuat ToQuat = FQuat::Identity;
+};
+
+/**
+ * Runs every active tween in a world in a single pass per tick.
+ *
+ * Each tweened component gets one SetRelativeLocationAndRotation call per tick, as a
+ * teleport without a sweep, rather than separate location and rotation updates that
+ * each propagate the transform and test for overlaps.
+ *
+ * Value tweens (float, vector, rotator, color, transform) are stored per type in packed
+ * channels. Each tick a channel is advanced, interpolated in one pass, then the results
+ * are written to their bindings; see FMStdTweenBinding::Setter. Only the float channel is
+ * batched across tweens, four to a register; the other channels fill a register per value.
+ */
+UCLASS()
+class MTASKS_API UMStdTweenSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+private:
+	TArray<FMStdTransformTweenState> TransformTweens;
+
+	/** Index into TransformTweens by tween id */
+	TMap<int32, int32> TransformTweenIndex;
+
+	TMStdTweenChannel<float> FloatTweens;
+	TMStdTweenChannel<FVector4> VectorTweens;
+	TMStdTweenChannel<FVector4> RotatorTweens;
+	TMStdTweenChannel<FVector4> ColorTweens;
+	TMStdTweenChannel<FMStdTweenTransformValue> ValueTransformTweens;
+
+	int32 NextSerial = 0;
+
+public:
+	/** Find the tween subsystem for a world */
+	static UMStdTweenSubsystem* Get(const UObject* WorldContextObject);
+
+	/** Start tweening a component; any tween already running on the same component is stopped */
+	UFUNCTION(BlueprintCallable, Category="MTasks|Standard|Tween")
+	FMStdTweenHandle StartTransformTween(const FMStdTransformTween& Tween);
+
+	/** Stop a tween, optionally jumping to its final values */
+	UFUNCTION(BlueprintCallable, Category="MTasks|Standard|Tween")
+	void StopTween(FMStdTweenHandle Handle, bool JumpToEnd);
+
+	/** Is this tween still running? */
+	UFUNCTION(BlueprintCallable, Category="MTasks|Standard|Tween")
+	bool IsTweenActive(FMStdTweenHandle Handle) const;
+
+	/** Advance a transform tween started with AdvancedByOwner; returns false once it has finished, or was stopped */
+	UFUNCTION(BlueprintCallable, Category="MTasks|Standard|Tween")
+	bool AdvanceTween(FMStdTweenHandle Handle, float DeltaTime);
+
+	/** Start a value tween; the binding must be a float property */
+	FMStdTweenHandle StartTween(const FMStdTweenBinding& Binding, float From, float To, const FMStdTweenTiming& Timing);
+
+	/** Start a value tween; the binding must be an FVector property, or a scene component's relative location */
+	FMStdTweenHandle StartTween(const FMStdTweenBinding& Binding, const FVector& From, const FVector& To, const FMStdTweenTiming& Timing);
+
+	/** Start a value tween along the shortest path; the binding must be an FRotator property, or a scene component's relative rotation */
+	FMStdTweenHandle StartTween(const FMStdTweenBinding& Binding, const FRotator& From, const FRotator& To, const FMStdTweenTiming& Timing);
+
+	/** Start a value tween; the binding must be an FLinearColor property */
+	FMStdTweenHandle StartTween(const FMStdTweenBinding& Binding, const FLinearColor& From, const FLinearColor& To, const FMStdTweenTiming& Timing);
+
+	/** Start a value tween; the binding must be an FTransform property, or a scene component's relative transform */
+	FMStdTweenHandle StartTween(const FMStdTweenBinding& Binding, const FTransform& From, const FTransform& To, const FMStdTweenTiming& Timing);
+
+	/** Map linear progress 0..1 through an easing function or curve */
+	static float EvaluateEase(EMStdEase Ease, const UCurveFloat* Curve, float Alpha);
+
+	// FTickableGameObject
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override;
+	virtual TStatId GetStatId() const override;
+
+private:
+	/** Apply a transform tween at the given linear progress */
+	static void ApplyTransformTween(const FMStdTransformTweenState& State, float Alpha);
+
+	void RemoveTransformTweenAt(int32 Index);
+
+	/** Advance and apply one transform tween; returns false if it finished, or lost its target, and was removed */
+	bool StepTransformTween(int32 Index, float DeltaTime);
+
+	/** Make a new handle id; the low bits record which channel owns the tween */
+	int32 MakeId(int32 Channel);
+
+	void TickTransformTweens(float DeltaTime);
+	void TickValueTweens(float DeltaTime);
+};
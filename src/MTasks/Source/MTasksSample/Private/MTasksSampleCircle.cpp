@@ -3,46 +3,91 @@
 
 #include "MTasksSampleCircle.h"
 
+void UMTasksSampleCircle::BindToTask(UMTask* Task)
+{
+	UnbindFromTask();
+	if (!Task) return;
+
+	BoundTask = Task;
+	Task->OnProgress.AddDynamic(this, &UMTasksSampleCircle::OnTaskProgress);
+	OnTaskProgress(Task, Task->Progress);
+}
+
+void UMTasksSampleCircle::UnbindFromTask()
+{
+	if (const auto Task = BoundTask.Get())
+	{
+		Task->OnProgress.RemoveDynamic(this, &UMTasksSampleCircle::OnTaskProgress);
+	}
+	BoundTask = nullptr;
+}
+
+void UMTasksSampleCircle::NativeDestruct()
+{
+	UnbindFromTask();
+	Super::NativeDestruct();
+}
+
+void UMTasksSampleCircle::OnTaskProgress(UMTask* Task, float TaskProgress)
+{
+	const auto NextProgress = FMath::RoundToInt(TaskProgress * Nodes);
+	if (NextProgress == Progress) return;
+	Progress = NextProgress;
+	Invalidate(EInvalidateWidgetReason::Paint);
+}
+
 int32 UMTasksSampleCircle::NativePaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect,
                                        FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle,
                                        bool bParentEnabled) const
 {
+	if (Nodes <= 0) return LayerId;
+
 	auto InDrawEffects = ESlateDrawEffect::None;
 
 	const auto Geom = AllottedGeometry.ToPaintGeometry(FVector2D(Radius * 2, Radius * 2), FSlateLayoutTransform(1.0f, Offset));
 
-	TArray<FVector2D> Points;
-	constexpr auto MaxAngle = PI * 2;
 	auto const EffectiveProgress = Progress > Nodes ? Nodes : (Progress < 0 ? 0 : Progress);
+	if (EffectiveProgress == 0) return LayerId;
 
-	// Ring
-	Points.Reset();
-	for (auto i = 0; i <= EffectiveProgress; i++)
+	UpdatePathCache();
+	if (CachedProgress != EffectiveProgress)
 	{
-		const auto Partial = AngleOffset + MaxAngle * (i / static_cast<float>(Nodes));
-		auto const X = FMath::Sin(Partial) * Radius;
-		auto const Y = FMath::Cos(Partial) * Radius;
-		Points.Add(FVector2D(X, Y));
+		// Reset keeps the allocation, so this only copies
+		CachedPoints.Reset();
+		CachedPoints.Append(CachedPath.GetData(), (EffectiveProgress + 1) * 3);
+		CachedProgress = EffectiveProgress;
 	}
-	FSlateDrawElement::MakeLines(OutDrawElements, LayerId, Geom, Points, InDrawEffects, Color, true, Thickness);
 
-	// Internal
-	if (EffectiveProgress > 0)
+	// The ring and all the spokes in a single element. Each spoke is drawn out and back,
+	// so translucent colors show the spokes slightly stronger than the ring.
+	FSlateDrawElement::MakeLines(OutDrawElements, LayerId, Geom, CachedPoints, InDrawEffects, Color, true, Thickness);
+
+	return LayerId;
+}
+
+void UMTasksSampleCircle::UpdatePathCache() const
+{
+	if (CachedNodes == Nodes && CachedRadius == Radius && CachedInnerRadius == InnerRadius && CachedAngleOffset == AngleOffset)
 	{
-		for (auto i = 0; i <= EffectiveProgress; i++)
-		{
-			const auto Partial = AngleOffset + MaxAngle * (i / static_cast<float>(Nodes));
-			auto const X = FMath::Sin(Partial) * Radius;
-			auto const Y = FMath::Cos(Partial) * Radius;
-			auto const Sx = FMath::Sin(Partial) * InnerRadius;
-			auto const Sy = FMath::Cos(Partial) * InnerRadius;
-
-			Points.Reset();
-			Points.Add(FVector2D(Sx, Sy));
-			Points.Add(FVector2D(X, Y));
-			FSlateDrawElement::MakeLines(OutDrawElements, LayerId, Geom, Points, InDrawEffects, Color, true, Thickness);
-		}
+		return;
 	}
 
-	return LayerId;
+	CachedNodes = Nodes;
+	CachedRadius = Radius;
+	CachedInnerRadius = InnerRadius;
+	CachedAngleOffset = AngleOffset;
+	CachedProgress = -1;
+
+	constexpr auto MaxAngle = PI * 2;
+	CachedPath.Reset((Nodes + 1) * 3);
+	for (auto i = 0; i <= Nodes; i++)
+	{
+		const auto Partial = AngleOffset + MaxAngle * (i / static_cast<float>(Nodes));
+		float Sin, Cos;
+		FMath::SinCos(&Sin, &Cos, Partial);
+		const auto Outer = FVector2D(Sin * Radius, Cos * Radius);
+		CachedPath.Add(Outer);
+		CachedPath.Add(FVector2D(Sin * InnerRadius, Cos * InnerRadius));
+		CachedPath.Add(Outer);
+	}
 }
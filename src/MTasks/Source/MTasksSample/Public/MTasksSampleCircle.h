@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "Blueprint/UserWidget.h"
 #include "Components/Widget.h"
+#include "MTask.h"
 #include "UObject/Object.h"
 #include "MTasksSampleCircle.generated.h"
 
@@ -44,5 +45,38 @@ public:
 	UPROPERTY(BlueprintReadWrite, EditAnywhere)
 	FLinearColor Color;
 	
+	/** Drive Progress from a task's progress events instead of a binding or tick */
+	UFUNCTION(BlueprintCallable)
+	void BindToTask(UMTask* Task);
+
+	/** Stop following the bound task, if any */
+	UFUNCTION(BlueprintCallable)
+	void UnbindFromTask();
+
+	virtual void NativeDestruct() override;
+
 	virtual int32 NativePaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const override;
+
+private:
+	TWeakObjectPtr<UMTask> BoundTask;
+
+	UFUNCTION()
+	void OnTaskProgress(UMTask* Task, float TaskProgress);
+
+	// Paint cache; geometry only changes when the shape does, so keep it between paints
+
+	/** Ring and spokes as one polyline: outer[i], inner[i], outer[i] for every node */
+	mutable TArray<FVector2D> CachedPath;
+
+	/** The prefix of CachedPath covering the current progress */
+	mutable TArray<FVector2D> CachedPoints;
+
+	mutable int CachedNodes = -1;
+	mutable float CachedRadius = 0;
+	mutable float CachedInnerRadius = 0;
+	mutable float CachedAngleOffset = 0;
+	mutable int CachedProgress = -1;
+
+	/** Rebuild the cached path if the shape changed */
+	void UpdatePathCache() const;
 };
@@ -0,0 +1,66 @@
+#include "Debug/MTaskGraph.h"
+#include "MExecutor.h"
+#include "MTasksSample/Tests/Internal/MTestUtils.h"
+#include "Standard/MStdDelay.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(MTaskGraphTest, "Tests.Debug.MTaskGraphTest",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool MTaskGraphTest::RunTest(const FString& Parameters)
+{
+	auto* WorldObject = UMTestUtils::GetAnyGameWorld();
+	auto const Exec = NewObject<UMTaskExecutor>(WorldObject);
+	Exec->Initialize(FMTaskExecutorPolicy(), true);
+
+	// A -> B -> C, with D as the rejected branch of A
+	auto const A = UMStdDelay::StdDelay(WorldObject, -1, 1);
+	auto const B = UMStdDelay::StdDelay(WorldObject, -1, 1);
+	auto const C = UMStdDelay::StdDelay(WorldObject, -1, 1);
+	auto const D = UMStdDelay::StdDelay(WorldObject, -1, 1);
+	A->Then(EMTaskState::Resolved, B);
+	A->Then(EMTaskState::Rejected, D);
+	B->Then(EMTaskState::Resolved, C);
+	A->Start(Exec);
+	Exec->Tick(0.1f);
+
+	auto Graph = FMTaskGraph::Capture(*Exec);
+	check(Graph.Nodes.Num() == 4);
+	check(Graph.Roots.Num() == 1);
+	check(Graph.Nodes[Graph.Roots[0]].Object == A);
+	check(Graph.Nodes[Graph.Roots[0]].HasTiming());
+	check(Graph.SerialChains.Num() == 1);
+	check(Graph.SerialChains[0].Nodes.Num() == 3);
+
+	// Once A completes, the graph is still found from B through its parent
+	Exec->Tick(1.0f);
+	Exec->Tick(0.1f);
+	check(B->IsRunning());
+	Graph = FMTaskGraph::Capture(*Exec);
+	check(Graph.Nodes[Graph.Roots[0]].Object == A);
+
+	// Nodes are A, B, D, C; A resolved, so the critical path follows B however slow the rejected branch is
+	check(Graph.Nodes[0].State == EMTaskState::Resolved);
+	Graph.Nodes[1].Duration = 0.1;
+	Graph.Nodes[2].Duration = 0.5;
+	Graph.Nodes[3].Duration = 0.1;
+	Graph.Analyze();
+	check(Graph.CriticalPath.Num() == 3);
+	check(Graph.Nodes[Graph.CriticalPath[2]].Object == C);
+	check(!Graph.Nodes[2].IsOnCriticalPath);
+	check(FMath::IsNearlyEqual(Graph.CriticalPathDuration, Graph.Nodes[0].Duration + 0.2));
+
+	// Had A been rejected, only D would run
+	Graph.Nodes[0].State = EMTaskState::Rejected;
+	Graph.Analyze();
+	check(Graph.CriticalPath.Num() == 2);
+	check(Graph.Nodes[Graph.CriticalPath[1]].Object == D);
+	check(FMath::IsNearlyEqual(Graph.CriticalPathDuration, Graph.Nodes[0].Duration + 0.5));
+
+	check(Graph.ToDot().StartsWith(TEXT("digraph MTasks")));
+
+	Exec->CancelTree(A);
+	Exec->Tick(0.1f);
+	check(FMTaskGraph::Capture(*Exec).Nodes.Num() == 0);
+
+	return true;
+}
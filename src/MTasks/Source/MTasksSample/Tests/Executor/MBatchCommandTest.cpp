@@ -0,0 +1,35 @@
+#include "Actors/MStdExecutor.h"
+#include "MTasksSample/Tests/Internal/MTestBatchCommand.h"
+#include "MTasksSample/Tests/Internal/MTestUtils.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(MBatchCommandTest, "Tests.Executor.MBatchCommandTest",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool MBatchCommandTest::RunTest(const FString& Parameters)
+{
+	auto* WorldObject = UMTestUtils::GetAnyGameWorld();
+	auto const Exec = AMStdExecutor::GetStdExecutor(WorldObject);
+
+	// One executor entry for 5000 agents, polled in parallel chunks
+	auto const Batch = NewObject<UMTestBatchCommand>(WorldObject);
+	Batch->ParallelChunkSize = 512;
+	for (auto i = 0; i < 5000; i++)
+	{
+		FMTestBatchAgent Agent;
+		Agent.Remaining = 1 + (i % 3);
+		Batch->Agents.Add(Agent);
+	}
+
+	Batch->Start(Exec);
+	Exec->Tick(1.0);
+	check(Batch->Finished == 1667);
+	check(Batch->IsRunning());
+
+	Exec->Tick(1.0);
+	Exec->Tick(1.0);
+	check(Batch->Finished == 5000);
+	check(Batch->TotalPolls == 1667 * 1 + 1667 * 2 + 1666 * 3);
+	check(Batch->State == EMTaskState::Resolved);
+
+	return true;
+}
@@ -0,0 +1,112 @@
+#include "MExecutor.h"
+#include "MTasksSample/Tests/Internal/MTestSlowTask.h"
+#include "MTasksSample/Tests/Internal/MTestUtils.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(MExecutorAdaptiveTest, "Tests.Executor.MExecutorAdaptiveTest",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool MExecutorAdaptiveTest::RunTest(const FString& Parameters)
+{
+	auto* WorldObject = UMTestUtils::GetAnyGameWorld();
+	auto Policy = FMTaskExecutorPolicy();
+	Policy.Adaptive = true;
+	Policy.TargetFrameTime = 1.0f / 60.0f;
+	Policy.AdaptiveMinScale = 0.25f;
+	Policy.TickBudget = 0.01f;
+	Policy.MaxStartsPerTick = 8;
+	auto const SlowFrame = 0.05f;
+	auto const FastFrame = 0.005f;
+
+	/** Slow frames back off the budget, admission and low priority poll rate down to AdaptiveMinScale */
+	auto const Exec = NewObject<UMTaskExecutor>(WorldObject);
+	Exec->Initialize(Policy, true);
+	Exec->TickWithFrameTime(0.1f, SlowFrame);
+	check(FMath::IsNearlyEqual(Exec->GetStats().ThrottleScale, 0.8f));
+	check(Exec->GetStats().LowPriorityStride == 2);
+	check(FMath::IsNearlyEqual(Exec->GetStats().EffectiveTickBudget, 0.008f));
+	check(Exec->GetStats().EffectiveMaxStartsPerTick == 6);
+
+	for (auto i = 0; i < 100; i++)
+	{
+		Exec->TickWithFrameTime(0.1f, SlowFrame);
+	}
+	check(FMath::IsNearlyEqual(Exec->GetStats().ThrottleScale, 0.25f));
+	check(Exec->GetStats().LowPriorityStride == 4);
+	check(FMath::IsNearlyEqual(Exec->GetStats().EffectiveTickBudget, 0.0025f));
+	check(Exec->GetStats().EffectiveMaxStartsPerTick == 2);
+
+	// Once the history shows headroom, it recovers a step at a time, and then all the way
+	for (auto i = 0; i < 60; i++)
+	{
+		Exec->TickWithFrameTime(0.1f, FastFrame);
+	}
+	check(Exec->GetStats().ThrottleScale > 0.25f && Exec->GetStats().ThrottleScale < 1.0f);
+	check(Exec->GetStats().LowPriorityStride > 1 && Exec->GetStats().LowPriorityStride < 4);
+
+	for (auto i = 0; i < 200; i++)
+	{
+		Exec->TickWithFrameTime(0.1f, FastFrame);
+	}
+	check(Exec->GetStats().ThrottleScale == 1.0f);
+	check(Exec->GetStats().LowPriorityStride == 1);
+	check(Exec->GetStats().EffectiveTickBudget == Policy.TickBudget);
+	check(Exec->GetStats().EffectiveMaxStartsPerTick == Policy.MaxStartsPerTick);
+
+	/** Throttled, each low priority entry is polled on its own tick of the stride, however the queue changes */
+	auto const Strided = NewObject<UMTaskExecutor>(WorldObject);
+	Strided->Initialize(Policy, true);
+	Strided->SetBudgetClock([] { return 0.0; }); // Only the stride decides who is polled
+	for (auto i = 0; i < 100; i++)
+	{
+		Strided->TickWithFrameTime(0.1f, SlowFrame);
+	}
+	check(Strided->GetStats().LowPriorityStride == 4);
+
+	TArray<UMTestSlowTask*> Tasks;
+	for (auto i = 0; i < 4; i++)
+	{
+		auto const Task = NewObject<UMTestSlowTask>(WorldObject);
+		Task->Priority = EMTaskPriority::Low;
+		Task->Start(Strided);
+		Tasks.Add(Task);
+	}
+
+	TArray<int32> Phases;
+	Phases.Init(INDEX_NONE, Tasks.Num());
+	for (auto Tick = 0; Tick < 4; Tick++)
+	{
+		Strided->TickWithFrameTime(0.1f, SlowFrame);
+		for (auto i = 0; i < Tasks.Num(); i++)
+		{
+			if (Tasks[i]->Polls == 1 && Phases[i] == INDEX_NONE) Phases[i] = Tick;
+		}
+	}
+	for (auto i = 0; i < Tasks.Num(); i++)
+	{
+		check(Tasks[i]->Polls == 1);
+	}
+
+	// Removing one entry shifts the others in the queue, but not in the stride
+	Tasks[0]->Cancel(Strided);
+	for (auto Tick = 4; Tick < 12; Tick++)
+	{
+		TArray<int32> Before;
+		for (auto i = 1; i < Tasks.Num(); i++)
+		{
+			Before.Add(Tasks[i]->Polls);
+		}
+		Strided->TickWithFrameTime(0.1f, SlowFrame);
+		for (auto i = 1; i < Tasks.Num(); i++)
+		{
+			auto const WasPolled = Tasks[i]->Polls != Before[i - 1];
+			check(WasPolled == (Tick % 4 == Phases[i]));
+		}
+	}
+
+	for (auto i = 1; i < Tasks.Num(); i++)
+	{
+		Strided->CancelTask(Tasks[i]);
+	}
+	Strided->TickWithFrameTime(0.1f, SlowFrame);
+	return true;
+}
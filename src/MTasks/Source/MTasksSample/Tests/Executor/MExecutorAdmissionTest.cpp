@@ -0,0 +1,73 @@
+#include "MExecutor.h"
+#include "MTasksSample/Tests/Internal/MTestSlowTask.h"
+#include "MTasksSample/Tests/Internal/MTestUtils.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(MExecutorAdmissionTest, "Tests.Executor.MExecutorAdmissionTest",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool MExecutorAdmissionTest::RunTest(const FString& Parameters)
+{
+	auto* WorldObject = UMTestUtils::GetAnyGameWorld();
+	auto Policy = FMTaskExecutorPolicy();
+	Policy.MaxStartsPerTick = 2;
+	auto const Exec = NewObject<UMTaskExecutor>(WorldObject);
+	Exec->Initialize(Policy, true);
+
+	/** A burst of starts is admitted over several ticks, in order */
+	TArray<UMTestSlowTask*> Tasks;
+	for (auto i = 0; i < 5; i++)
+	{
+		auto const Task = NewObject<UMTestSlowTask>(WorldObject);
+		Task->Start(Exec);
+		Tasks.Add(Task);
+	}
+
+	Exec->Tick(0.1f);
+	check(Tasks[0]->Polls == 1 && Tasks[1]->Polls == 1);
+	check(Tasks[2]->Polls == 0 && Tasks[3]->Polls == 0 && Tasks[4]->Polls == 0);
+
+	Exec->Tick(0.1f);
+	check(Tasks[0]->Polls == 2 && Tasks[1]->Polls == 2);
+	check(Tasks[2]->Polls == 1 && Tasks[3]->Polls == 1);
+	check(Tasks[4]->Polls == 0);
+
+	Exec->Tick(0.1f);
+	check(Tasks[4]->Polls == 1);
+	for (auto const Task : Tasks)
+	{
+		Exec->CancelTask(Task);
+	}
+	Exec->Tick(0.1f);
+
+	/** First polls of entries admitted together are spread out */
+	Policy.MaxStartsPerTick = 0;
+	Policy.SpreadFirstPollTicks = 3;
+	auto const SpreadExec = NewObject<UMTaskExecutor>(WorldObject);
+	SpreadExec->Initialize(Policy, true);
+	Tasks.Reset();
+	for (auto i = 0; i < 3; i++)
+	{
+		auto const Task = NewObject<UMTestSlowTask>(WorldObject);
+		Task->Start(SpreadExec);
+		Tasks.Add(Task);
+	}
+
+	auto Polled = 0;
+	for (auto Tick = 1; Tick <= 3; Tick++)
+	{
+		SpreadExec->Tick(0.1f);
+		auto FirstPolls = 0;
+		for (auto const Task : Tasks)
+		{
+			FirstPolls += Task->Polls > 0 ? 1 : 0;
+		}
+		check(FirstPolls == ++Polled); // One more entry reaches its first poll each tick
+	}
+
+	for (auto const Task : Tasks)
+	{
+		SpreadExec->CancelTask(Task);
+	}
+	SpreadExec->Tick(0.1f);
+	return true;
+}
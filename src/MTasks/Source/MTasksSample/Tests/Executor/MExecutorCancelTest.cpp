@@ -0,0 +1,112 @@
+#include "Actors/MStdExecutor.h"
+#include "MCancellationToken.h"
+#include "MTasksSample/Tests/Internal/MTestSlowTask.h"
+#include "MTasksSample/Tests/Internal/MTestUtils.h"
+#include "Standard/MStdDelay.h"
+#include "Standard/MStdResult.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(MExecutorCancelTest, "Tests.Executor.MExecutorCancelTest",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool MExecutorCancelTest::RunTest(const FString& Parameters)
+{
+	auto* WorldObject = UMTestUtils::GetAnyGameWorld();
+	auto const Exec = AMStdExecutor::GetStdExecutor(WorldObject);
+
+	/** Tree workflow */
+	auto const A = UMStdDelay::StdDelay(WorldObject, -1, 2);
+	auto const B = UMStdDelay::StdDelay(WorldObject, -1, 2);
+	auto const C = UMStdResult::Resolved(WorldObject);
+	auto const D = UMStdResult::Resolved(WorldObject);
+	auto const Unstarted = NewObject<UMTestSlowTask>(WorldObject);
+	auto RejectedA = false;
+	auto NotifiedDescendants = 0;
+
+	A->Then(EMTaskState::Resolved, B);
+	A->Then(EMTaskState::Rejected, D);
+	B->Then(EMTaskState::Resolved, C);
+	C->Then(EMTaskState::Resolved, Unstarted);
+
+	A->Update.AddLambda([&](const UMTask* Task)
+	{
+		RejectedA = Task->State == EMTaskState::Rejected;
+	});
+
+	// Descendants that never started still hear the outcome
+	for (auto const Descendant : TArray<UMTask*>{B, C, D, Unstarted})
+	{
+		Descendant->Update.AddLambda([&](const UMTask* Task)
+		{
+			NotifiedDescendants += Task->State == EMTaskState::Rejected ? 1 : 0;
+		});
+	}
+
+	A->Start(Exec);
+	Exec->Tick(1.0);
+	Exec->CancelTree(A);
+	Exec->Tick(1.0);
+	Exec->Tick(1.0);
+	check(RejectedA);
+	check(B->State == EMTaskState::Rejected);
+	check(C->State == EMTaskState::Rejected);
+	check(D->State == EMTaskState::Rejected); // The rejected branch is part of the tree too
+	check(NotifiedDescendants == 4);
+	check(Unstarted->Starts == 0 && Unstarted->Ends == 0); // Never started, so never ended
+
+	/** Token workflow */
+	auto const Token = UMCancellationToken::CreateToken(WorldObject);
+	auto const E = UMStdDelay::StdDelay(WorldObject, -1, 10);
+	auto const F = UMStdDelay::StdDelay(WorldObject, -1, 10);
+	auto const G = UMStdResult::Resolved(WorldObject);
+	E->CancellationToken = Token;
+	F->CancellationToken = Token;
+
+	E->Start(Exec);
+	F->Start(Exec);
+	G->Start(Exec);
+	Exec->Tick(1.0);
+	Token->Cancel();
+	Exec->Tick(1.0);
+	check(E->State == EMTaskState::Rejected);
+	check(F->State == EMTaskState::Rejected);
+	check(G->State == EMTaskState::Resolved);
+
+	// A child inheriting a token that is already cancelled is rejected without starting
+	auto const InheritToken = UMCancellationToken::CreateToken(WorldObject);
+	auto const Parent = UMStdDelay::StdDelay(WorldObject, -1, 10);
+	auto const Inheriting = NewObject<UMTestSlowTask>(WorldObject);
+	auto NotifiedInheriting = false;
+	Parent->CancellationToken = InheritToken;
+	Parent->Then(EMTaskState::Rejected, Inheriting);
+	Inheriting->Update.AddLambda([&](const UMTask* Task)
+	{
+		NotifiedInheriting = Task->State == EMTaskState::Rejected;
+	});
+
+	Parent->Start(Exec);
+	Exec->Tick(1.0);
+	InheritToken->Cancel();
+	Exec->Tick(1.0);
+	Exec->Tick(1.0);
+	check(Parent->State == EMTaskState::Rejected);
+	check(Inheriting->State == EMTaskState::Rejected);
+	check(Inheriting->Starts == 0 && Inheriting->Polls == 0 && Inheriting->Ends == 0);
+	check(NotifiedInheriting);
+
+	/** Context workflow */
+	auto const H = UMStdDelay::StdDelay(WorldObject, -1, 10);
+	auto const I = UMStdDelay::StdDelay(WorldObject, -1, 10);
+	auto const J = UMStdDelay::StdDelay(WorldObject, -1, 10);
+	H->Start(Exec, H);
+	I->Start(Exec, H);
+	J->Start(Exec, J);
+	Exec->Tick(1.0);
+	Exec->CancelAllByContext(H);
+	Exec->Tick(1.0);
+	check(H->State == EMTaskState::Rejected);
+	check(I->State == EMTaskState::Rejected);
+	check(J->State == EMTaskState::Running);
+	Exec->CancelTask(J);
+
+	return true;
+}
@@ -0,0 +1,69 @@
+#include "Actors/MStdExecutor.h"
+#include "MTasksSample/Tests/Internal/MTestUtils.h"
+#include "Standard/MStdResult.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(MExecutorCompletionBenchmark, "Tests.Executor.MExecutorCompletionBenchmark",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+namespace MExecutorCompletionBenchmarkInternals
+{
+	constexpr int TaskCount = 10000;
+
+	/** Start TaskCount tasks, bind each one using Bind, and time the single tick that completes them all */
+	template <typename TBind>
+	double MeasureCompletion(UObject* WorldObject, UMTaskExecutor* Exec, TBind Bind)
+	{
+		for (auto i = 0; i < TaskCount; i++)
+		{
+			auto const Task = UMStdResult::Resolved(WorldObject);
+			Bind(Task);
+			Task->Start(Exec);
+		}
+
+		auto const StartTime = FPlatformTime::Seconds();
+		Exec->Tick(1.0);
+		return FPlatformTime::Seconds() - StartTime;
+	}
+}
+
+bool MExecutorCompletionBenchmark::RunTest(const FString& Parameters)
+{
+	using namespace MExecutorCompletionBenchmarkInternals;
+
+	auto* WorldObject = UMTestUtils::GetAnyGameWorld();
+	auto const Exec = AMStdExecutor::GetStdExecutor(WorldObject);
+	Exec->SetDebug(false);
+
+	/** Nobody is listening */
+	auto const Unbound = MeasureCompletion(WorldObject, Exec, [](UMTask*)
+	{
+	});
+
+	/** Native continuation slot */
+	auto ContinuationCalls = 0;
+	auto const Continuation = MeasureCompletion(WorldObject, Exec, [&](UMTask* Task)
+	{
+		Task->Continuation.BindLambda([&](const UMTask*)
+		{
+			ContinuationCalls += 1;
+		});
+	});
+
+	/** Native multicast */
+	auto UpdateCalls = 0;
+	auto const Update = MeasureCompletion(WorldObject, Exec, [&](UMTask* Task)
+	{
+		Task->Update.AddLambda([&](const UMTask*)
+		{
+			UpdateCalls += 1;
+		});
+	});
+
+	check(ContinuationCalls == TaskCount);
+	check(UpdateCalls == TaskCount);
+
+	AddInfo(FString::Printf(TEXT("Completing %d tasks in one tick: unbound %.3fms, continuation %.3fms, multicast %.3fms"),
+	                        TaskCount, Unbound * 1000.0, Continuation * 1000.0, Update * 1000.0));
+
+	return true;
+}
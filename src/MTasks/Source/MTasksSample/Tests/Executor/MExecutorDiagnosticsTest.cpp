@@ -0,0 +1,48 @@
+#include "MExecutor.h"
+#include "MTasksSample/Tests/Internal/MTestSlowTask.h"
+#include "MTasksSample/Tests/Internal/MTestUtils.h"
+#include "Standard/MStdDelay.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(MExecutorDiagnosticsTest, "Tests.Executor.MExecutorDiagnosticsTest",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool MExecutorDiagnosticsTest::RunTest(const FString& Parameters)
+{
+	auto* WorldObject = UMTestUtils::GetAnyGameWorld();
+	auto const Exec = NewObject<UMTaskExecutor>(WorldObject);
+	Exec->Initialize(FMTaskExecutorPolicy(), true);
+
+	auto const Slow = NewObject<UMTestSlowTask>(WorldObject);
+	Slow->PollSeconds = 0.001;
+	Slow->Priority = EMTaskPriority::High;
+	auto const Delay = UMStdDelay::StdDelay(WorldObject, -1, 10);
+	Slow->Start(Exec);
+	Delay->Start(Exec);
+	check(Exec->GetPendingDepth() == 2);
+
+	// Class costs are only kept while profiling
+	Exec->Tick(0.1f);
+	check(Exec->GetPendingDepth() == 0);
+	check(Exec->GetQueueDepth(EMTaskPriority::High) == 1);
+	check(Exec->GetQueueDepth(EMTaskPriority::Normal) == 1);
+	check(Exec->GetClassCosts().Num() == 0);
+	check(Exec->GetStats().TickTime > 0);
+
+	Exec->SetClassProfiling(true);
+	Exec->Tick(0.1f);
+	Exec->Tick(0.1f);
+	auto const Cost = Exec->GetClassCosts().Find(UMTestSlowTask::StaticClass());
+	check(Cost && Cost->Polls == 2);
+	check(Cost->Seconds >= 0.002f);
+	check(Cost->PeakSeconds >= 0.001f);
+	check(Exec->GetClassCosts().Contains(UMStdDelay::StaticClass()));
+
+	// Cancel by class matches subclasses, and only live entries
+	check(Exec->CancelAllByClass(UMTask::StaticClass()) == 2);
+	Exec->Tick(0.1f);
+	check(Slow->State == EMTaskState::Rejected);
+	check(Delay->State == EMTaskState::Rejected);
+	check(Exec->CancelAllByClass(UMTask::StaticClass()) == 0);
+
+	return true;
+}
@@ -0,0 +1,75 @@
+#include "MExecutor.h"
+#include "MTasksSample/Tests/Internal/MTestIdleCommand.h"
+#include "MTasksSample/Tests/Internal/MTestUtils.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(MExecutorLeaseTest, "Tests.Executor.MExecutorLeaseTest",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool MExecutorLeaseTest::RunTest(const FString& Parameters)
+{
+	auto* WorldObject = UMTestUtils::GetAnyGameWorld();
+	auto Policy = FMTaskExecutorPolicy();
+	Policy.CommandPolicy.LeaseSeconds = 1;
+	auto const Exec = NewObject<UMTaskExecutor>(WorldObject);
+	Exec->Initialize(Policy, true);
+
+	// Renewing keeps a command alive; letting the lease lapse rejects it
+	auto const Leased = NewObject<UMTestIdleCommand>(WorldObject);
+	Leased->Start(Exec);
+	for (auto i = 0; i < 5; i++)
+	{
+		Leased->Renew();
+		Exec->Tick(0.6f);
+	}
+	check(Leased->State == EMTaskState::Running);
+	Exec->Tick(0.6f);
+	Exec->Tick(0.6f);
+	check(Leased->State == EMTaskState::Rejected);
+
+	// A per-class policy can suspend instead; suspended commands are not polled
+	FMTaskCommandPolicy Idle;
+	Idle.LeaseSeconds = 1;
+	Idle.LeaseAction = EMTaskLeaseAction::Suspend;
+	Policy.CommandPolicies.Add(UMTestIdleCommand::StaticClass(), Idle);
+	Exec->Initialize(Policy, true);
+	auto const Suspended = NewObject<UMTestIdleCommand>(WorldObject);
+	Suspended->Start(Exec);
+	Exec->Tick(0.6f);
+	Exec->Tick(0.6f);
+	check(Suspended->Suspended);
+	check(Suspended->State == EMTaskState::Running);
+	check(Exec->GetSuspendedDepth() == 1);
+	auto const Polls = Suspended->Polls;
+	Exec->Tick(0.6f);
+	check(Suspended->Polls == Polls);
+
+	// Renewing resumes it
+	Suspended->Renew();
+	check(!Suspended->Suspended);
+	Exec->Tick(0.6f);
+	check(Exec->GetSuspendedDepth() == 0);
+	check(Suspended->Polls == Polls + 1);
+
+	// Cancelling a suspended command still ends it
+	Suspended->Suspend();
+	Exec->Tick(0.1f);
+	check(Exec->GetSuspendedDepth() == 1);
+	Exec->CancelCommand(Suspended);
+	Exec->Tick(0.1f);
+	check(Exec->GetSuspendedDepth() == 0);
+	check(Suspended->State == EMTaskState::Rejected);
+
+	// Commands can also be capped outright
+	Policy.CommandPolicies.Reset();
+	Policy.CommandPolicy = FMTaskCommandPolicy();
+	Policy.CommandPolicy.MaxExecutionDuration = 1;
+	Exec->Initialize(Policy, true);
+	auto const Capped = NewObject<UMTestIdleCommand>(WorldObject);
+	Capped->Start(Exec);
+	Exec->Tick(0.6f);
+	check(Capped->State == EMTaskState::Running);
+	Exec->Tick(0.6f);
+	check(Capped->State == EMTaskState::Rejected);
+
+	return true;
+}
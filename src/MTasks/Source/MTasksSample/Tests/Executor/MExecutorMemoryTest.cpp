@@ -0,0 +1,42 @@
+#include "MExecutor.h"
+#include "MTasksSample/Tests/Internal/MTestUtils.h"
+#include "Standard/MStdDelay.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(MExecutorMemoryTest, "Tests.Executor.MExecutorMemoryTest",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool MExecutorMemoryTest::RunTest(const FString& Parameters)
+{
+	auto* WorldObject = UMTestUtils::GetAnyGameWorld();
+	auto const Exec = NewObject<UMTaskExecutor>(WorldObject);
+	Exec->Initialize(FMTaskExecutorPolicy(), true);
+
+	auto const Empty = Exec->GetMemoryUsage();
+	check(Empty.EventLog > 0);
+
+	for (auto i = 0; i < 10; i++)
+	{
+		auto const Delay = UMStdDelay::StdDelay(WorldObject, -1, 10);
+		Delay->Then(EMTaskState::Resolved, UMStdDelay::StdDelay(WorldObject, -1, 1));
+		Delay->Update.AddLambda([](UMTask*)
+		{
+		});
+		Delay->Start(Exec);
+	}
+	check(Exec->GetMemoryUsage().Pending > 0);
+	Exec->Tick(0.5f);
+	check(Exec->GetMemoryUsage().ReadyQueues > 0);
+	check(Exec->GetResourceSizeBytes(EResourceSizeMode::Exclusive) == Exec->GetMemoryUsage().GetTotal());
+
+	// Children that have not started yet are only counted through their parents
+	TMap<UClass*, FMTaskClassFootprint> Footprints;
+	Exec->GetClassFootprints(Footprints);
+	auto const Footprint = Footprints.Find(UMStdDelay::StaticClass());
+	check(Footprint && Footprint->Count == 10);
+	check(Footprint->ObjectBytes == 10 * UMStdDelay::StaticClass()->GetStructureSize());
+	check(Footprint->ChildrenBytes > 0);
+	check(Footprint->DelegateBytes > 0);
+	check(FMath::IsNearlyEqual(Footprint->OldestSeconds, 0.5f));
+
+	return true;
+}
@@ -0,0 +1,99 @@
+#include "MExecutor.h"
+#include "MTasksSample/Tests/Internal/MTestIdleCommand.h"
+#include "MTasksSample/Tests/Internal/MTestSlowTask.h"
+#include "MTasksSample/Tests/Internal/MTestUtils.h"
+#include "Standard/MStdDelay.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(MExecutorOrphanTest, "Tests.Executor.MExecutorOrphanTest",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool MExecutorOrphanTest::RunTest(const FString& Parameters)
+{
+	auto* WorldObject = UMTestUtils::GetAnyGameWorld();
+	auto const Exec = NewObject<UMTaskExecutor>(WorldObject);
+	auto Policy = FMTaskExecutorPolicy();
+	Policy.OrphanAction = EMTaskOrphanAction::Report;
+	Policy.OrphanScanInterval = 1000;
+	Policy.UnboundCommandTimeout = 1;
+	Exec->Initialize(Policy, true);
+
+	// B only runs if A is rejected, so once A resolves B and C can never run
+	auto const A = UMStdDelay::StdDelay(WorldObject, -1, 1);
+	auto const B = UMStdDelay::StdDelay(WorldObject, -1, 1);
+	auto const C = UMStdDelay::StdDelay(WorldObject, -1, 1);
+	A->Then(EMTaskState::Rejected, B);
+	B->Then(EMTaskState::Resolved, C);
+	A->Start(Exec);
+
+	// A command nobody is listening to, and one somebody is
+	auto const Unbound = NewObject<UMTestIdleCommand>(WorldObject);
+	auto const Listened = NewObject<UMTestIdleCommand>(WorldObject);
+	Listened->Update.AddLambda([](UMCommand*)
+	{
+	});
+	Unbound->Start(Exec);
+	Listened->Start(Exec);
+
+	// The branch A didn't take is never reported, and only Collect releases it
+	for (auto i = 0; i < 4; i++)
+	{
+		Exec->Tick(0.5f);
+	}
+	check(A->State == EMTaskState::Resolved);
+	check(B->State == EMTaskState::Idle);
+	check(C->State == EMTaskState::Idle);
+
+	// Reporting leaves everything alone, and reports it again next time
+	check(Exec->ScanForOrphans(false) == 1);
+	check(Exec->ScanForOrphans(false) == 1);
+	check(Unbound->IsRunning());
+	check(B->State == EMTaskState::Idle);
+
+	check(Exec->ScanForOrphans(true) == 1);
+	Exec->Tick(0.5f);
+	check(Unbound->State == EMTaskState::Rejected);
+	check(Listened->IsRunning());
+	check(Exec->GetStats().OrphansCollected == 1);
+	check(Exec->ScanForOrphans(true) == 0);
+
+	// A child on both branches runs whichever is taken
+	auto const Parent = UMStdDelay::StdDelay(WorldObject, -1, 1);
+	auto const Either = UMStdDelay::StdDelay(WorldObject, -1, 1);
+	Parent->Then(EMTaskState::Rejected, Either);
+	Parent->Then(EMTaskState::Resolved, Either);
+	Parent->Start(Exec);
+	Exec->Tick(0.5f);
+	Exec->Tick(0.5f);
+	Exec->Tick(0.5f);
+	check(Parent->State == EMTaskState::Resolved);
+	check(Either->IsRunning());
+
+	Exec->CancelTask(Either);
+
+	// With Collect, the branch not taken is rejected when its parent completes; its listeners are
+	// notified, but it was never started so it never ends
+	Exec->Policy.OrphanAction = EMTaskOrphanAction::Collect;
+	auto const Taken = UMStdDelay::StdDelay(WorldObject, -1, 1);
+	auto const NotTaken = NewObject<UMTestSlowTask>(WorldObject);
+	auto const Chained = UMStdDelay::StdDelay(WorldObject, -1, 1);
+	auto NotTakenState = EMTaskState::Idle;
+	Taken->Then(EMTaskState::Rejected, NotTaken);
+	NotTaken->Then(EMTaskState::Resolved, Chained);
+	NotTaken->Update.AddLambda([&](const UMTask* Task)
+	{
+		NotTakenState = Task->State;
+	});
+	Taken->Start(Exec);
+	for (auto i = 0; i < 4; i++)
+	{
+		Exec->Tick(0.5f);
+	}
+	check(Taken->State == EMTaskState::Resolved);
+	check(NotTaken->State == EMTaskState::Rejected);
+	check(Chained->State == EMTaskState::Rejected);
+	check(NotTakenState == EMTaskState::Rejected);
+	check(NotTaken->Starts == 0);
+	check(NotTaken->Ends == 0);
+	Exec->CancelCommand(Listened);
+	return true;
+}
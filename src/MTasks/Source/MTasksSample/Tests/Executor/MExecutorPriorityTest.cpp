@@ -0,0 +1,81 @@
+#include "MExecutor.h"
+#include "MTasksSample/Tests/Internal/MTestSlowTask.h"
+#include "MTasksSample/Tests/Internal/MTestUtils.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(MExecutorPriorityTest, "Tests.Executor.MExecutorPriorityTest",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool MExecutorPriorityTest::RunTest(const FString& Parameters)
+{
+	auto* WorldObject = UMTestUtils::GetAnyGameWorld();
+	auto const Exec = NewObject<UMTaskExecutor>(WorldObject);
+	Exec->Initialize(FMTaskExecutorPolicy(), true);
+
+	/** Highest priority is polled first, whatever order the tasks were started in */
+	TArray<UObject*> Order;
+	TArray<UMTestSlowTask*> Levels;
+	for (auto const Priority : {EMTaskPriority::Low, EMTaskPriority::Normal, EMTaskPriority::High})
+	{
+		auto const Task = NewObject<UMTestSlowTask>(WorldObject);
+		Task->Priority = Priority;
+		Task->PollOrder = &Order;
+		Task->Start(Exec);
+		Levels.Add(Task);
+	}
+	Exec->Tick(0.1f);
+	check(Order.Num() == 3);
+	check(Order[0] == Levels[2]);
+	check(Order[1] == Levels[1]);
+	check(Order[2] == Levels[0]);
+	for (auto const Task : Levels)
+	{
+		Exec->CancelTask(Task);
+	}
+	Exec->Tick(0.1f);
+
+	/** Under budget pressure lower levels are deferred, but still get MinPollsPerLevel polls each tick */
+	auto Now = 0.0;
+	Exec->SetBudgetClock([&Now] { return Now; });
+
+	auto Policy = FMTaskExecutorPolicy();
+	Policy.TickBudget = 0.001f;
+	Exec->Initialize(Policy, true);
+
+	auto const Hog = NewObject<UMTestSlowTask>(WorldObject);
+	Hog->Priority = EMTaskPriority::High;
+	Hog->PollSeconds = 0.002;
+	Hog->Clock = &Now;
+	Hog->Start(Exec);
+
+	TArray<UMTestSlowTask*> Starved;
+	for (auto i = 0; i < 3; i++)
+	{
+		auto const Task = NewObject<UMTestSlowTask>(WorldObject);
+		Task->Start(Exec);
+		Starved.Add(Task);
+	}
+
+	Exec->Tick(0.1f);
+	check(Hog->Polls == 1);
+	check(Starved[0]->Polls == 1);
+	check(Starved[1]->Polls == 0);
+	check(Starved[2]->Polls == 0);
+
+	// Polling resumes from the first deferred entry, so every entry gets its turn
+	Exec->Tick(0.1f);
+	Exec->Tick(0.1f);
+	check(Hog->Polls == 3);
+	for (auto const Task : Starved)
+	{
+		check(Task->Polls == 1);
+	}
+
+	Exec->CancelTask(Hog);
+	for (auto const Task : Starved)
+	{
+		Exec->CancelTask(Task);
+	}
+	Exec->Tick(0.1f);
+	Exec->SetBudgetClock(nullptr);
+	return true;
+}
@@ -0,0 +1,78 @@
+#include "MExecutor.h"
+#include "MTasksSample/Tests/Internal/MTestSlowTask.h"
+#include "MTasksSample/Tests/Internal/MTestUtils.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(MExecutorScheduleTest, "Tests.Executor.MExecutorScheduleTest",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool MExecutorScheduleTest::RunTest(const FString& Parameters)
+{
+	auto* WorldObject = UMTestUtils::GetAnyGameWorld();
+	auto const Exec = NewObject<UMTaskExecutor>(WorldObject);
+	Exec->Initialize(FMTaskExecutorPolicy(), true);
+
+	/** Tick intervals; entries started together are staggered over the interval */
+	TArray<UMTestSlowTask*> Tasks;
+	for (auto i = 0; i < 4; i++)
+	{
+		auto const Task = NewObject<UMTestSlowTask>(WorldObject);
+		Task->PollIntervalTicks = 4;
+		Task->Start(Exec);
+		Tasks.Add(Task);
+	}
+
+	TArray<int32> FirstPollTick;
+	FirstPollTick.Init(INDEX_NONE, Tasks.Num());
+	for (auto Tick = 0; Tick < 4; Tick++)
+	{
+		Exec->Tick(0.25f);
+		for (auto i = 0; i < Tasks.Num(); i++)
+		{
+			if (Tasks[i]->Polls > 0 && FirstPollTick[i] == INDEX_NONE) FirstPollTick[i] = Tick;
+		}
+	}
+	TSet<int32> Phases;
+	for (auto i = 0; i < Tasks.Num(); i++)
+	{
+		check(Tasks[i]->Polls == 1);
+		Phases.Add(FirstPollTick[i]);
+	}
+	check(Phases.Num() == 4);
+
+	for (auto Tick = 0; Tick < 8; Tick++)
+	{
+		Exec->Tick(0.25f);
+	}
+	for (auto const Task : Tasks)
+	{
+		check(Task->Polls == 3);
+		check(Task->LastDeltaTime == 1.0f); // Every skipped tick is carried into the next poll
+	}
+	for (auto const Task : Tasks)
+	{
+		Exec->CancelTask(Task);
+	}
+	Exec->Tick(0.25f);
+
+	/**
+	 * Second intervals; a fresh executor, so the first entry is staggered by Frac(0.618) of its interval.
+	 * Admitted at 0.25s, first due at 0.868s and then every second; polled at 1s, 2s, 3s, 4s and 5s.
+	 */
+	auto const SecondsExec = NewObject<UMTaskExecutor>(WorldObject);
+	SecondsExec->Initialize(FMTaskExecutorPolicy(), true);
+
+	auto const Seconds = NewObject<UMTestSlowTask>(WorldObject);
+	Seconds->PollIntervalSeconds = 1.0f;
+	Seconds->Start(SecondsExec);
+	for (auto Tick = 0; Tick < 20; Tick++)
+	{
+		SecondsExec->Tick(0.25f);
+	}
+	check(Seconds->Polls == 5);
+	check(Seconds->LastDeltaTime == 1.0f);
+	check(Seconds->TotalDeltaTime == 5.0f); // No time is lost between polls
+
+	SecondsExec->CancelTask(Seconds);
+	SecondsExec->Tick(0.25f);
+	return true;
+}
@@ -0,0 +1,66 @@
+#include "Actors/MStdExecutor.h"
+#include "MTasksSample/Tests/Internal/MTestSlowTask.h"
+#include "MTasksSample/Tests/Internal/MTestUtils.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(MExecutorWatchdogTest, "Tests.Executor.MExecutorWatchdogTest",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool MExecutorWatchdogTest::RunTest(const FString& Parameters)
+{
+	auto* WorldObject = UMTestUtils::GetAnyGameWorld();
+	auto const Exec = AMStdExecutor::GetStdExecutor(WorldObject);
+	auto const SavedPolicy = Exec->Policy;
+
+	Exec->Policy.WatchdogThreshold = 0.001f;
+	Exec->Policy.WatchdogStrikes = 2;
+
+	/** Repeat offenders are rejected */
+	Exec->Policy.WatchdogAction = EMTaskWatchdogAction::Reject;
+	auto const Slow = NewObject<UMTestSlowTask>(WorldObject);
+	Slow->PollSeconds = 0.002;
+	auto const Fast = NewObject<UMTestSlowTask>(WorldObject);
+
+	Slow->Start(Exec);
+	Fast->Start(Exec);
+	Exec->Tick(0.1f);
+	check(Slow->IsRunning()); // One strike
+	Exec->Tick(0.1f);
+	check(Slow->State == EMTaskState::Rejected);
+	check(Fast->IsRunning());
+
+	/** Throttled offenders are polled less often */
+	Exec->Policy.WatchdogAction = EMTaskWatchdogAction::Throttle;
+	auto const Throttled = NewObject<UMTestSlowTask>(WorldObject);
+	Throttled->PollSeconds = 0.002;
+	Throttled->Start(Exec);
+	for (auto i = 0; i < 10; i++)
+	{
+		Exec->Tick(0.1f);
+	}
+	check(Throttled->IsRunning());
+	check(Throttled->Polls == 4); // Ticks 0, 1, 3 and 7; each doubled interval applies from the poll that earned it
+
+	/** Demoted offenders move to the Low queue, behind everything that still has budget */
+	Exec->Policy.WatchdogAction = EMTaskWatchdogAction::Demote;
+	auto const Demoted = NewObject<UMTestSlowTask>(WorldObject);
+	Demoted->PollSeconds = 0.002;
+	Demoted->Priority = EMTaskPriority::High;
+	Demoted->Start(Exec);
+	Exec->Tick(0.1f);
+	auto const HighDepth = Exec->GetQueueDepth(EMTaskPriority::High);
+	auto const LowDepth = Exec->GetQueueDepth(EMTaskPriority::Low);
+	Exec->Tick(0.1f);
+	check(Demoted->IsRunning());
+	check(Exec->GetQueueDepth(EMTaskPriority::High) == HighDepth - 1);
+	check(Exec->GetQueueDepth(EMTaskPriority::Low) == LowDepth + 1);
+	auto const Polls = Demoted->Polls;
+	Exec->Tick(0.1f);
+	check(Demoted->Polls == Polls + 1); // Still polled from its new queue
+
+	Exec->CancelTask(Fast);
+	Exec->CancelTask(Throttled);
+	Exec->CancelTask(Demoted);
+	Exec->Tick(0.1f);
+	Exec->Policy = SavedPolicy;
+	return true;
+}
@@ -0,0 +1,105 @@
+#include "Actors/MStdExecutor.h"
+#include "Async/ParallelFor.h"
+#include "MTaskEventLog.h"
+#include "MTasksSample/Tests/Internal/MTestUtils.h"
+#include "Standard/MStdDelay.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(MTaskEventLogTest, "Tests.Executor.MTaskEventLogTest",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool MTaskEventLogTest::RunTest(const FString& Parameters)
+{
+	auto* WorldObject = UMTestUtils::GetAnyGameWorld();
+	auto const Exec = AMStdExecutor::GetStdExecutor(WorldObject);
+
+	// The executor records the lifecycle of a task
+	auto const Delay = UMStdDelay::StdDelay(WorldObject, -1, 1);
+	Delay->Start(Exec);
+	Exec->Tick(1.0);
+	Exec->Tick(1.0);
+
+	TArray<EMTaskEvent> Kinds;
+	Exec->GetEventLog().ForEach([&](const FMTaskEvent& Event)
+	{
+		if (Event.ObjectId == Delay->GetUniqueID())
+		{
+			Kinds.Add(Event.Kind);
+		}
+	});
+	check(Kinds.Num() >= 3);
+	check(Kinds[0] == EMTaskEvent::Queued);
+	check(Kinds.Last() == EMTaskEvent::Completed);
+
+	// Promoted children link back to their parent, and show up in both exports
+	auto const Parent = UMStdDelay::StdDelay(WorldObject, -1, 1);
+	auto const Child = UMStdDelay::StdDelay(WorldObject, -1, 1);
+	Parent->Then(EMTaskState::Resolved, Child);
+	Parent->Start(Exec);
+	for (auto i = 0; i < 4; i++)
+	{
+		Exec->Tick(1.0);
+	}
+	check(Child->State == EMTaskState::Resolved);
+
+	auto PromotedFrom = 0u;
+	Exec->GetEventLog().ForEach([&](const FMTaskEvent& Event)
+	{
+		if (Event.Kind == EMTaskEvent::Promoted && Event.ObjectId == Child->GetUniqueID())
+		{
+			PromotedFrom = Event.RelatedId;
+		}
+	});
+	check(PromotedFrom == Parent->GetUniqueID());
+
+	auto const Trace = Exec->GetEventLog().ToChromeTrace();
+	check(Trace.StartsWith(TEXT("{\"displayTimeUnit\"")));
+	check(Trace.Contains(TEXT("\"ph\":\"X\"")));
+	check(Trace.Contains(TEXT("\"ph\":\"s\"")));
+
+	TArray<FString> Rows;
+	Exec->GetEventLog().ToCsv().ParseIntoArrayLines(Rows);
+	check(Rows.Num() == Exec->GetEventLog().Num() + 1);
+
+	// The log keeps only the most recent events, oldest first
+	FMTaskEventLog Log;
+	Log.SetCapacity(3);
+	for (auto i = 0; i < 10; i++)
+	{
+		Log.Record(EMTaskEvent::Transition, Delay, EMTaskState::Running, EMTaskState::Resolved, i, false);
+	}
+	check(Log.Num() == 4);
+
+	TArray<int64> Ticks;
+	Log.ForEach([&](const FMTaskEvent& Event)
+	{
+		Ticks.Add(Event.Tick);
+	});
+	check(Ticks.Num() == 4);
+	check(Ticks[0] == 6);
+	check(Ticks[3] == 9);
+
+	Log.Reset();
+	check(Log.Num() == 0);
+
+	// Writers that wrap onto the same slot from several threads never leave a torn event behind
+	Log.SetCapacity(4);
+	ParallelFor(20000, [&](int32 Index)
+	{
+		auto const Even = Index % 2 == 0;
+		Log.Record(Even ? EMTaskEvent::Started : EMTaskEvent::Completed, Delay, Even ? EMTaskState::Idle : EMTaskState::Running,
+		           Even ? EMTaskState::Running : EMTaskState::Resolved, Index, Even);
+	});
+	auto Visited = 0;
+	Log.ForEach([&](const FMTaskEvent& Event)
+	{
+		auto const Even = Event.Tick % 2 == 0;
+		check(Event.Kind == (Even ? EMTaskEvent::Started : EMTaskEvent::Completed));
+		check(Event.From == (Even ? EMTaskState::Idle : EMTaskState::Running));
+		check(Event.To == (Even ? EMTaskState::Running : EMTaskState::Resolved));
+		check(Event.IsCommand == Even);
+		Visited += 1;
+	});
+	check(Visited <= 4);
+
+	return true;
+}
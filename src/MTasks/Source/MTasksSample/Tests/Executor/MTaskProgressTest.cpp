@@ -0,0 +1,43 @@
+#include "Actors/MStdExecutor.h"
+#include "MTasksSample/Tests/Internal/MTestUtils.h"
+#include "Standard/MStdDelay.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(MTaskProgressTest, "Tests.Executor.MTaskProgressTest",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool MTaskProgressTest::RunTest(const FString& Parameters)
+{
+	auto* WorldObject = UMTestUtils::GetAnyGameWorld();
+	auto const Exec = AMStdExecutor::GetStdExecutor(WorldObject);
+
+	auto const Delay = UMStdDelay::StdDelay(WorldObject, -1, 4);
+	TArray<float> Reported;
+	Delay->ProgressUpdate.AddLambda([&](UMTask* Task, float Progress)
+	{
+		Reported.Add(Progress);
+	});
+
+	// Changes made between polls are coalesced into one event
+	Delay->SetProgress(0.1f);
+	Delay->SetProgress(0.2f);
+	check(Reported.Num() == 0);
+
+	Delay->Start(Exec);
+	Exec->Tick(1.0);
+	check(Reported.Num() == 1);
+	check(FMath::IsNearlyEqual(Reported[0], 0.25f));
+
+	Exec->Tick(1.0);
+	Exec->Tick(1.0);
+	Exec->Tick(1.0);
+	check(Reported.Num() == 4);
+	check(FMath::IsNearlyEqual(Reported[3], 1.0f));
+	check(Delay->State == EMTaskState::Resolved);
+
+	// Setting the same value again is not a change
+	Delay->SetProgress(1.0f);
+	Delay->FlushProgress();
+	check(Reported.Num() == 4);
+
+	return true;
+}
@@ -0,0 +1,82 @@
+#include "GameFramework/PlayerController.h"
+#include "MExecutor.h"
+#include "MTasksSample/Tests/Internal/MTestCameraPawn.h"
+#include "MTasksSample/Tests/Internal/MTestPickable.h"
+#include "MTasksSample/Tests/Internal/MTestUtils.h"
+#include "Standard/Pickable/MStdPickRegistry.h"
+#include "Standard/Pickable/MStdPickService.h"
+#include "Standard/Pickable/MStdPickerTimed.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(MTaskQueryCacheTest, "Tests.Executor.MTaskQueryCacheTest",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool MTaskQueryCacheTest::RunTest(const FString& Parameters)
+{
+	auto* WorldObject = UMTestUtils::GetAnyGameWorld();
+	auto const Exec = NewObject<UMTaskExecutor>(WorldObject);
+	Exec->Initialize(FMTaskExecutorPolicy(), true);
+
+	auto const Controller = WorldObject->SpawnActor<APlayerController>(FVector::ZeroVector, FRotator::ZeroRotator);
+	auto const Pawn = WorldObject->SpawnActor<AMTestCameraPawn>(FVector::ZeroVector, FRotator::ZeroRotator);
+	Controller->Possess(Pawn);
+
+	// Asking twice in a tick runs each query once
+	Exec->Tick(0.1f);
+	auto& Queries = Exec->GetQueryCache();
+	check(Queries.GetQueriesRun() == 0);
+	auto const ViewTarget = Queries.GetViewTarget(Controller);
+	check(Queries.GetViewTarget(Controller) == ViewTarget);
+	check(Queries.GetQueriesRun() == 1);
+
+	FVector FirstLocation, SecondLocation;
+	FRotator FirstRotation, SecondRotation;
+	Queries.GetPlayerViewPoint(Controller, FirstLocation, FirstRotation);
+	Queries.GetPlayerViewPoint(Controller, SecondLocation, SecondRotation);
+	check(FirstLocation == SecondLocation && FirstRotation == SecondRotation);
+	check(Queries.GetQueriesRun() == 2);
+
+	// Invalidating a player asks again
+	Queries.Invalidate(Controller);
+	Queries.GetViewTarget(Controller);
+	Queries.GetPlayerViewPoint(Controller, FirstLocation, FirstRotation);
+	check(Queries.GetQueriesRun() == 4);
+
+	// The next tick starts empty
+	Exec->Tick(0.1f);
+	check(Queries.GetQueriesRun() == 0);
+	Queries.GetViewTarget(Controller);
+	check(Queries.GetQueriesRun() == 1);
+
+	// Pickers with different queries, running on the executor, share one view point per tick
+	auto const Target = WorldObject->SpawnActor<AMTestPickable>(FVector(200, 0, 0), FRotator::ZeroRotator);
+	UMStdPickRegistry::RegisterPickable(Target);
+	FMStdPickRequest Near;
+	Near.Mode = EMStdPickerMode::Gamepad;
+	Near.PickActorType = AMTestPickable::StaticClass();
+	Near.MaxDistance = 1000;
+	Near.HalfAngleDegrees = 30;
+	auto Far = Near;
+	Far.MaxDistance = 2000;
+
+	auto const Service = NewObject<UMStdPickService>(WorldObject);
+	auto const NearPicker = NewObject<UMStdPickerTimed>(WorldObject);
+	auto const FarPicker = NewObject<UMStdPickerTimed>(WorldObject);
+	NearPicker->OwningExecutor = Exec;
+	FarPicker->OwningExecutor = Exec;
+	Service->AddPicker(NearPicker, NearPicker, Controller, Near);
+	Service->AddPicker(FarPicker, FarPicker, Controller, Far);
+	check(Service->NumQueries() == 2);
+
+	Exec->Tick(0.1f);
+	check(Service->Resolve(NearPicker).Focus.Get() == Target);
+	check(Service->Resolve(FarPicker).Focus.Get() == Target);
+	check(Queries.GetQueriesRun() == 1);
+
+	Service->RemovePicker(NearPicker);
+	Service->RemovePicker(FarPicker);
+	UMStdPickRegistry::UnregisterPickable(Target);
+	Target->Destroy();
+	Controller->Destroy();
+	Pawn->Destroy();
+	return true;
+}
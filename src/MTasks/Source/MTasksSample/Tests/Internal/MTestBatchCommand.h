@@ -0,0 +1,52 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MBatchCommand.h"
+#include "MTestBatchCommand.generated.h"
+
+struct FMTestBatchAgent
+{
+	float Remaining = 0;
+	int Polls = 0;
+};
+
+/** Agents count down their time remaining and leave the batch when done */
+UCLASS(NotBlueprintable)
+class MTASKSSAMPLE_API UMTestBatchCommand : public UMBatchCommand
+{
+	GENERATED_BODY()
+
+public:
+	TMBatchAgents<FMTestBatchAgent> Agents;
+
+	int Finished = 0;
+
+	int TotalPolls = 0;
+
+protected:
+	virtual int32 GetBatchNum() const override
+	{
+		return Agents.Num();
+	}
+
+	virtual void OnPollBatch(int32 Begin, int32 End, float DeltaTime) override
+	{
+		for (auto& Agent : Agents.Range(Begin, End))
+		{
+			Agent.Remaining -= DeltaTime;
+			Agent.Polls += 1;
+		}
+	}
+
+	virtual void OnBatchPolled(float DeltaTime) override
+	{
+		Finished += Agents.RemoveAllSwap([this](const FMTestBatchAgent& Agent)
+		{
+			if (Agent.Remaining > 0) return false;
+			TotalPolls += Agent.Polls;
+			return true;
+		});
+	}
+};
@@ -0,0 +1,27 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Camera/CameraComponent.h"
+#include "GameFramework/Pawn.h"
+#include "MTestCameraPawn.generated.h"
+
+/** A pawn with a camera, offset from its root so a camera tween has somewhere to go */
+UCLASS(NotBlueprintable)
+class MTASKSSAMPLE_API AMTestCameraPawn : public APawn
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY()
+	UCameraComponent* Camera;
+
+	AMTestCameraPawn()
+	{
+		RootComponent = CreateDefaultSubobject<USceneComponent>(TEXT("Root"));
+		Camera = CreateDefaultSubobject<UCameraComponent>(TEXT("Camera"));
+		Camera->SetupAttachment(RootComponent);
+		Camera->SetRelativeLocation(FVector(-100, 0, 50));
+	}
+};
@@ -0,0 +1,23 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MCommand.h"
+#include "MTestIdleCommand.generated.h"
+
+/** A command that never finishes and does nothing */
+UCLASS(NotBlueprintable)
+class MTASKSSAMPLE_API UMTestIdleCommand : public UMCommand
+{
+	GENERATED_BODY()
+
+public:
+	int Polls = 0;
+
+	virtual EMTaskState OnPoll_Implementation(float DeltaTime) override
+	{
+		Polls += 1;
+		return EMTaskState::Running;
+	}
+};
@@ -0,0 +1,50 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/SceneComponent.h"
+#include "GameFramework/Actor.h"
+#include "Standard/Pickable/MStdPickable.h"
+#include "MTestPickable.generated.h"
+
+/** A pickable actor that counts the callbacks it receives */
+UCLASS(NotBlueprintable)
+class MTASKSSAMPLE_API AMTestPickable : public AActor, public IMStdPickable
+{
+	GENERATED_BODY()
+
+public:
+	int HighlightCalls = 0;
+	int PickingCalls = 0;
+	int PickedCalls = 0;
+
+	AMTestPickable()
+	{
+		// Placeable, for the registry
+		RootComponent = CreateDefaultSubobject<USceneComponent>(TEXT("Root"));
+	}
+
+	/** CanBeSelected refuses this picker */
+	TWeakObjectPtr<UObject> RefusedPicker;
+
+	virtual bool CanBeSelected_Implementation(UObject* ByPicker) override
+	{
+		return ByPicker != RefusedPicker.Get();
+	}
+
+	virtual void OnHighlight_Implementation(bool HasFocus) override
+	{
+		HighlightCalls += 1;
+	}
+
+	virtual void OnPicking_Implementation(float Elapsed, float Total) override
+	{
+		PickingCalls += 1;
+	}
+
+	virtual void OnPicked_Implementation(float TimeSpentPicking) override
+	{
+		PickedCalls += 1;
+	}
+};
@@ -0,0 +1,61 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MTask.h"
+#include "MTestSlowTask.generated.h"
+
+/** A task that never finishes, and spends PollSeconds in every poll */
+UCLASS(NotBlueprintable)
+class MTASKSSAMPLE_API UMTestSlowTask : public UMTask
+{
+	GENERATED_BODY()
+
+public:
+	double PollSeconds = 0;
+
+	int Polls = 0;
+
+	/** Calls to OnStart and OnEnd */
+	int Starts = 0;
+	int Ends = 0;
+
+	/** DeltaTime passed to the last poll, and to all polls so far */
+	float LastDeltaTime = 0;
+	float TotalDeltaTime = 0;
+
+	/** If set, every poll appends this task; lets a test see the order tasks were polled in */
+	TArray<UObject*>* PollOrder = nullptr;
+
+	/** If set, polls advance this fake clock by PollSeconds instead of spending wall time */
+	double* Clock = nullptr;
+
+	virtual void OnStart_Implementation(UObject* Context) override
+	{
+		Starts += 1;
+	}
+
+	virtual void OnEnd_Implementation() override
+	{
+		Ends += 1;
+	}
+
+	virtual EMTaskState OnPoll_Implementation(float DeltaTime) override
+	{
+		Polls += 1;
+		LastDeltaTime = DeltaTime;
+		TotalDeltaTime += DeltaTime;
+		if (PollOrder) PollOrder->Add(this);
+		if (Clock)
+		{
+			*Clock += PollSeconds;
+			return EMTaskState::Running;
+		}
+		const auto Until = FPlatformTime::Seconds() + PollSeconds;
+		while (FPlatformTime::Seconds() < Until)
+		{
+		}
+		return EMTaskState::Running;
+	}
+};
@@ -0,0 +1,33 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "MTestTweenTarget.generated.h"
+
+/** Properties to tween; Value has a setter, which counts its calls */
+UCLASS(NotBlueprintable)
+class MTASKSSAMPLE_API UMTestTweenTarget : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY()
+	float Value = 0;
+
+	UPROPERTY()
+	FVector Offset = FVector::ZeroVector;
+
+	UPROPERTY()
+	FLinearColor Tint = FLinearColor::Black;
+
+	int SetValueCalls = 0;
+
+	UFUNCTION()
+	void SetValue(float InValue)
+	{
+		Value = InValue;
+		SetValueCalls += 1;
+	}
+};
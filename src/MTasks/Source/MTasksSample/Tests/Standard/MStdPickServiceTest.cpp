@@ -0,0 +1,59 @@
+#include "GameFramework/PlayerController.h"
+#include "MTasksSample/Tests/Internal/MTestPickable.h"
+#include "MTasksSample/Tests/Internal/MTestUtils.h"
+#include "Standard/Pickable/MStdPickRegistry.h"
+#include "Standard/Pickable/MStdPickService.h"
+#include "Standard/Pickable/MStdPickerTimed.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(MStdPickServiceTest, "Tests.Standard.MStdPickServiceTest",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool MStdPickServiceTest::RunTest(const FString& Parameters)
+{
+	auto* WorldObject = UMTestUtils::GetAnyGameWorld();
+
+	// A controller looking down +X at a registered pickable; gamepad mode, so no viewport is needed
+	auto const Controller = WorldObject->SpawnActor<APlayerController>(FVector::ZeroVector, FRotator::ZeroRotator);
+	auto const Target = WorldObject->SpawnActor<AMTestPickable>(FVector(200, 0, 0), FRotator::ZeroRotator);
+	UMStdPickRegistry::RegisterPickable(Target);
+
+	FMStdPickRequest Request;
+	Request.Mode = EMStdPickerMode::Gamepad;
+	Request.PickActorType = AMTestPickable::StaticClass();
+	Request.MaxDistance = 1000;
+	Request.HalfAngleDegrees = 30;
+
+	/** Two pickers share one query, but each filters the hit with its own CanBeSelected */
+	auto const Service = NewObject<UMStdPickService>(WorldObject);
+	auto const Accepted = NewObject<UMStdPickerTimed>(WorldObject);
+	auto const Refused = NewObject<UMStdPickerTimed>(WorldObject);
+	Target->RefusedPicker = Refused;
+	Service->AddPicker(Accepted, Accepted, Controller, Request);
+	Service->AddPicker(Refused, Refused, Controller, Request);
+	check(Service->NumQueries() == 1);
+
+	auto const AcceptedResult = Service->Resolve(Accepted);
+	auto const RefusedResult = Service->Resolve(Refused);
+	check(AcceptedResult.DidHit && RefusedResult.DidHit);
+	check(AcceptedResult.Location == RefusedResult.Location);
+	check(AcceptedResult.Focus.Get() == Target);
+	check(RefusedResult.Focus.Get() == nullptr);
+	check(Target->HighlightCalls == 1);
+
+	// The order pickers are polled in does not matter
+	Target->RefusedPicker = Accepted;
+	auto const Second = NewObject<UMStdPickerTimed>(WorldObject);
+	Service->AddPicker(Second, Second, Controller, Request);
+	check(Service->Resolve(Second).Focus.Get() == Target);
+
+	Service->RemovePicker(Accepted);
+	Service->RemovePicker(Refused);
+	Service->RemovePicker(Second);
+	check(Service->NumQueries() == 0);
+	check(Target->HighlightCalls == 4); // Each focused picker sent its own highlight on and off
+
+	UMStdPickRegistry::UnregisterPickable(Target);
+	Target->Destroy();
+	Controller->Destroy();
+	return true;
+}
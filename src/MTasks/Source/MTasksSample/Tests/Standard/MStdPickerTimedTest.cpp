@@ -0,0 +1,74 @@
+#include "MTasksSample/Tests/Internal/MTestPickable.h"
+#include "MTasksSample/Tests/Internal/MTestUtils.h"
+#include "Standard/Pickable/MStdPickerTimed.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(MStdPickerTimedTest, "Tests.Standard.MStdPickerTimedTest",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+namespace MStdPickerTimedTestInternals
+{
+	/** A running picker focused on Target. There is no player or pick service, so any trace cancels the pick */
+	UMStdPickerTimed* MakePicker(UObject* WorldObject, AActor* Target, float RevalidateInterval)
+	{
+		auto const Picker = NewObject<UMStdPickerTimed>(WorldObject);
+		Picker->Timeout = 100;
+		Picker->PickAfterTime = 1;
+		Picker->RevalidateInterval = RevalidateInterval;
+		Picker->PickerState = EMStdPickerState::Seeking;
+		Picker->State = EMTaskState::Running;
+		Picker->PickedActor = Target;
+		return Picker;
+	}
+}
+
+bool MStdPickerTimedTest::RunTest(const FString& Parameters)
+{
+	using namespace MStdPickerTimedTestInternals;
+	auto* WorldObject = UMTestUtils::GetAnyGameWorld();
+	auto const Target = WorldObject->SpawnActor<AMTestPickable>();
+
+	/** Press, release and press again */
+	auto const A = MakePicker(WorldObject, Target, 100);
+
+	A->OnPickSelectReleased(); // Ignored while seeking
+	check(A->PickerState == EMStdPickerState::Seeking);
+
+	A->OnPickSelectPressed();
+	check(A->PickerState == EMStdPickerState::PickStarted);
+
+	A->OnPoll(0.4f);
+	check(A->PickerState == EMStdPickerState::PickStarted); // Did not trace while picking
+	check(Target->PickingCalls == 1);
+	check(FMath::IsNearlyEqual(A->Progress, 0.4f));
+
+	A->OnPickSelectReleased();
+	check(A->PickerState == EMStdPickerState::Seeking);
+	check(A->PickedTimeSoFar == 0);
+	check(A->Progress == 0);
+
+	A->OnPickSelectPressed();
+	A->OnPoll(0.6f);
+	check(A->PickedTimeSoFar < A->PickAfterTime); // Release reset the time
+	A->OnPoll(0.6f);
+	check(A->PickerState == EMStdPickerState::Picked);
+	check(A->OnPoll(0) == EMTaskState::Resolved);
+	check(Target->PickedCalls == 1);
+
+	/** Revalidation runs on its cadence, and drops the pick when the target is no longer the focus */
+	auto const B = MakePicker(WorldObject, Target, 0.5f);
+	B->OnPickSelectPressed();
+	B->OnPoll(0.2f);
+	check(B->PickerState == EMStdPickerState::PickStarted);
+	B->OnPoll(0.4f);
+	check(B->PickerState == EMStdPickerState::Seeking);
+	check(B->Progress == 0);
+
+	/** A destroyed target drops the pick immediately */
+	auto const C = MakePicker(WorldObject, Target, 100);
+	C->OnPickSelectPressed();
+	Target->Destroy();
+	C->OnPoll(0.1f);
+	check(C->PickerState == EMStdPickerState::Seeking);
+
+	return true;
+}
@@ -0,0 +1,48 @@
+#include "GameFramework/PlayerController.h"
+#include "MExecutor.h"
+#include "MTasksSample/Tests/Internal/MTestCameraPawn.h"
+#include "MTasksSample/Tests/Internal/MTestUtils.h"
+#include "Standard/MStdPossess.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(MStdPossessTest, "Tests.Standard.MStdPossessTest",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool MStdPossessTest::RunTest(const FString& Parameters)
+{
+	auto* WorldObject = UMTestUtils::GetAnyGameWorld();
+	auto const Exec = NewObject<UMTaskExecutor>(WorldObject);
+	Exec->Initialize(FMTaskExecutorPolicy(), true);
+
+	auto const Controller = WorldObject->SpawnActor<APlayerController>();
+	auto const From = WorldObject->SpawnActor<AMTestCameraPawn>(FVector::ZeroVector, FRotator::ZeroRotator);
+	auto const To = WorldObject->SpawnActor<AMTestCameraPawn>(FVector(1000, 0, 0), FRotator::ZeroRotator);
+	Controller->Possess(From);
+
+	auto const Possess = UMStdPossess::StdPossess(WorldObject, Controller, To, 1.0f, false);
+	Possess->Start(Exec);
+	Exec->Tick(0.1f);
+	check(Possess->IsRunning());
+	check(Controller->GetPawn() == To);
+	auto const Start = To->Camera->GetRelativeLocation();
+	auto const End = FVector(-100, 0, 50);
+	check(!Start.Equals(End, 1.0f)); // The camera starts from the old view
+
+	// The world tick does not move the camera; only executor time does
+	auto const Tweens = UMStdTweenSubsystem::Get(WorldObject);
+	Tweens->Tick(10.0f);
+	check(To->Camera->GetRelativeLocation().Equals(Start));
+
+	Exec->Tick(0.5f);
+	check(Possess->IsRunning());
+	check(To->Camera->GetRelativeLocation().Equals(FMath::Lerp(Start, End, 0.5f), 1.0f));
+
+	Exec->Tick(0.6f);
+	check(Possess->State == EMTaskState::Resolved);
+	check(To->Camera->GetRelativeLocation().Equals(End, 1.0f));
+
+	Controller->UnPossess();
+	From->Destroy();
+	To->Destroy();
+	Controller->Destroy();
+	return true;
+}
@@ -0,0 +1,62 @@
+#include "MExecutor.h"
+#include "MTasksSample/Tests/Internal/MTestTweenTarget.h"
+#include "MTasksSample/Tests/Internal/MTestUtils.h"
+#include "Standard/Tween/MStdTween.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(MStdTweenTaskTest, "Tests.Standard.MStdTweenTaskTest",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool MStdTweenTaskTest::RunTest(const FString& Parameters)
+{
+	auto* WorldObject = UMTestUtils::GetAnyGameWorld();
+	auto const Exec = NewObject<UMTaskExecutor>(WorldObject);
+	Exec->Initialize(FMTaskExecutorPolicy(), true);
+	auto const Tweens = UMStdTweenSubsystem::Get(WorldObject);
+	auto const Target = NewObject<UMTestTweenTarget>(WorldObject);
+
+	/** Tasks resolve once the subsystem finishes their tween; values go through setters where there is one */
+	auto const Float = UMStdTweenFloat::StdTweenFloat(WorldObject, Target, TEXT("Value"), 0, 10, 1, EMStdEase::Linear, nullptr);
+	auto const Color = UMStdTweenColor::StdTweenColor(WorldObject, Target, TEXT("Tint"), FLinearColor::Black, FLinearColor::White, 1,
+	                                                  EMStdEase::Linear, nullptr);
+	Float->Start(Exec);
+	Color->Start(Exec);
+	Exec->Tick(0.1f);
+	check(Float->IsRunning() && Color->IsRunning());
+	check(Target->SetValueCalls == 1);
+
+	Tweens->Tick(0.5f);
+	check(FMath::IsNearlyEqual(Target->Value, 5.0f));
+	check(Target->SetValueCalls == 2);
+	check(Target->Tint.Equals(FLinearColor(0.5f, 0.5f, 0.5f, 1.0f)));
+
+	Tweens->Tick(0.5f);
+	Exec->Tick(0.1f);
+	check(Float->State == EMTaskState::Resolved);
+	check(Color->State == EMTaskState::Resolved);
+	check(FMath::IsNearlyEqual(Target->Value, 10.0f));
+
+	/** Cancelling stops the tween where it is */
+	auto const Vector = UMStdTweenVector::StdTweenVector(WorldObject, Target, TEXT("Offset"), FVector::ZeroVector, FVector(10, 0, 0), 1,
+	                                                     EMStdEase::Linear, nullptr);
+	Vector->Start(Exec);
+	Exec->Tick(0.1f);
+	Tweens->Tick(0.5f);
+	Exec->CancelTask(Vector);
+	Exec->Tick(0.1f);
+	Tweens->Tick(0.5f);
+	check(Vector->State == EMTaskState::Rejected);
+	check(Target->Offset.Equals(FVector(5, 0, 0)));
+
+	/** A tween whose target goes away is dropped on the next tick, and its task rejected */
+	auto const Doomed = NewObject<UMTestTweenTarget>(WorldObject);
+	auto const Lost = UMStdTweenFloat::StdTweenFloat(WorldObject, Doomed, TEXT("Value"), 0, 1, 10, EMStdEase::Linear, nullptr);
+	Lost->Start(Exec);
+	Exec->Tick(0.1f);
+	check(Lost->IsRunning());
+	Doomed->MarkPendingKill();
+	Tweens->Tick(0.1f);
+	Exec->Tick(0.1f);
+	check(Lost->State == EMTaskState::Rejected);
+
+	return true;
+}
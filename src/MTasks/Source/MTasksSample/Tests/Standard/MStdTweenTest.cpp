@@ -0,0 +1,55 @@
+#include "Camera/CameraComponent.h"
+#include "MTasksSample/Tests/Internal/MTestUtils.h"
+#include "Standard/Tween/MStdTweenSubsystem.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(MStdTweenTest, "Tests.Standard.MStdTweenTest",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool MStdTweenTest::RunTest(const FString& Parameters)
+{
+	auto* WorldObject = UMTestUtils::GetAnyGameWorld();
+	auto const Tweens = UMStdTweenSubsystem::Get(WorldObject);
+	check(Tweens);
+
+	// Enough cameras to run the float kernel's packed and tail paths
+	TArray<UCameraComponent*> Cameras;
+	TArray<FMStdTweenHandle> FovTweens;
+	TArray<FMStdTweenHandle> LocationTweens;
+	FMStdTweenTiming Timing;
+	Timing.Duration = 2;
+	for (auto i = 0; i < 7; i++)
+	{
+		auto const Camera = NewObject<UCameraComponent>(WorldObject);
+		Cameras.Add(Camera);
+		FovTweens.Add(Tweens->StartTween(FMStdTweenBinding::ForProperty(Camera, TEXT("FieldOfView")), 60.0f, 100.0f + i, Timing));
+		LocationTweens.Add(Tweens->StartTween(FMStdTweenBinding::ForProperty(Camera, NAME_None), FVector::ZeroVector, FVector(10 * i, 0, 0), Timing));
+	}
+
+	// Bindings are type checked
+	auto const BadTween = Tweens->StartTween(FMStdTweenBinding::ForProperty(Cameras[0], TEXT("FieldOfView")), FVector::ZeroVector, FVector::OneVector, Timing);
+	check(!BadTween.IsValid());
+
+	Tweens->Tick(1.0f);
+	for (auto i = 0; i < 7; i++)
+	{
+		check(FMath::IsNearlyEqual(Cameras[i]->FieldOfView, 60.0f + (40.0f + i) * 0.5f));
+		check(Cameras[i]->GetRelativeLocation().Equals(FVector(5 * i, 0, 0)));
+		check(Tweens->IsTweenActive(FovTweens[i]));
+	}
+
+	// Stopping one tween leaves the others packed and running
+	Tweens->StopTween(FovTweens[2], true);
+	check(!Tweens->IsTweenActive(FovTweens[2]));
+	check(FMath::IsNearlyEqual(Cameras[2]->FieldOfView, 102.0f));
+
+	Tweens->Tick(1.0f);
+	for (auto i = 0; i < 7; i++)
+	{
+		check(FMath::IsNearlyEqual(Cameras[i]->FieldOfView, 100.0f + i));
+		check(Cameras[i]->GetRelativeLocation().Equals(FVector(10 * i, 0, 0)));
+		check(!Tweens->IsTweenActive(FovTweens[i]));
+		check(!Tweens->IsTweenActive(LocationTweens[i]));
+	}
+
+	return true;
+}